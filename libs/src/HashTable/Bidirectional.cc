@@ -0,0 +1,334 @@
+#ifndef __HashTable_Bidirectional_Class__
+#define __HashTable_Bidirectional_Class__
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include "LinearProbing.cc"
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/Capacity.cc"
+#include "HashTable/typeNode/OpenAddressingFlat.cc"
+
+namespace HashTable
+{
+    namespace typeNode
+    {
+        // Entry of the reverse index of Bidirectional: one of the keys that hold a value and how many do.
+        template <class Tkey>
+        struct ValueKeys
+        {
+            Tkey key;
+            consts::t_count count;
+        };
+    }
+
+    /**
+     * A table with a second, value to key index kept next to it: contains(data) and findKeyByValue
+     * are hash lookups instead of a walk over every slot. Opt in by wrapping the table:
+     *
+     *     Bidirectional<LinearProbing<int, std::string>> table;
+     *
+     * @tparam Ttable LinearProbing, LinearProbingChainMethod or any table with the same interface.
+     * @tparam Tindex the reverse index: a table from Tdata to typeNode::ValueKeys<Tkey>. Tdata needs a
+     * hash function for it, the default one takes FunctionFibonacci (integers and std::string).
+     *
+     * Several keys may hold the same value: the index keeps one of them and the number of them.
+     * When that key goes and others stay, the next one is found by a walk over the table, so erasing
+     * keys of a value shared by many keys costs O(capacity) each time; unique values never walk.
+     *
+     * Only the operations that keep the index in sync are here: search gives const data, and
+     * emplace, batch and transparent lookups are left out. Every insert/add/erase/remove costs one
+     * more lookup and write in the index, indexBytes() tells its memory.
+     */
+    template <class Ttable, class Tindex = LinearProbing<typename Ttable::t_data, typename typeNode::ValueKeys<typename Ttable::t_key>, policy::CapacityPowerOfTwo<typename Ttable::t_data>>>
+    class Bidirectional
+    {
+    public:
+        using t_key = typename Ttable::t_key;
+        using t_data = typename Ttable::t_data;
+        using ConstIterator = typename Ttable::ConstIterator;
+
+    private:
+        using Tkey = t_key;
+        using Tdata = t_data;
+
+        Ttable table;
+        // Lookups of the index do not change it, contains and findKeyByValue stay const.
+        mutable Tindex index;
+
+        // search of LinearProbing gives the data, of LinearProbingChainMethod the node.
+        template <class Tvalue, class Tfound>
+        static Tvalue *valueOf(Tfound *found) noexcept
+        {
+            if constexpr (std::is_same<typename std::remove_const<Tfound>::type, typename std::remove_const<Tvalue>::type>::value)
+                return found;
+            else
+                return found ? &found->data : nullptr;
+        }
+
+        typeNode::ValueKeys<Tkey> *entryOf(const Tdata &data) const noexcept
+        {
+            return valueOf<typeNode::ValueKeys<Tkey>>(this->index.search(data));
+        }
+
+        const Tdata *dataOf(const Tkey &key) noexcept
+        {
+            return valueOf<const Tdata>(this->table.search(key));
+        }
+
+        void link(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            typeNode::ValueKeys<Tkey> *entry = this->entryOf(data);
+
+            if (entry)
+                ++entry->count;
+            else
+                this->index.insert(data, typeNode::ValueKeys<Tkey>{key, 1});
+        }
+
+        // "key" no longer holds "data". The table may still have "key", it is skipped.
+        void unlink(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            typeNode::ValueKeys<Tkey> *entry = this->entryOf(data);
+
+            if (!entry)
+                return;
+
+            if (!--entry->count)
+            {
+                this->index.erase(data);
+                return;
+            }
+
+            if (!(entry->key == key))
+                return;
+
+            for (const auto &item : this->table)
+            {
+                if (item.data == data && !(item.key == key))
+                {
+                    entry->key = item.key;
+                    return;
+                }
+            }
+        }
+
+    public:
+        explicit Bidirectional(const Ttable &table = Ttable()) : table(table)
+        {
+            for (const auto &item : this->table)
+                this->link(item.key, item.data);
+        }
+
+        const Ttable &get() const noexcept
+        {
+            return table;
+        }
+
+        consts::t_uIndex size() const noexcept
+        {
+            return this->table.size();
+        }
+
+        consts::t_uIndex capacity() const noexcept
+        {
+            return this->table.capacity();
+        }
+
+        consts::t_stat getLoadFactorMin() const noexcept
+        {
+            return this->table.getLoadFactorMin();
+        }
+
+        consts::t_stat getLoadFactorMax() const noexcept
+        {
+            return this->table.getLoadFactorMax();
+        }
+
+        consts::t_stat setLoadFactorMin(consts::t_stat newLoadFactorMin) noexcept(false)
+        {
+            return this->table.setLoadFactorMin(newLoadFactorMin);
+        }
+
+        consts::t_stat setLoadFactorMax(consts::t_stat newLoadFactorMax) noexcept(false)
+        {
+            return this->table.setLoadFactorMax(newLoadFactorMax);
+        }
+
+        policy::Growth getGrowth() const noexcept
+        {
+            return this->table.getGrowth();
+        }
+
+        policy::Growth setGrowth(const policy::Growth &newGrowth) noexcept(false)
+        {
+            return this->table.setGrowth(newGrowth);
+        }
+
+        consts::t_stat loadFactor() const
+        {
+            return this->table.loadFactor();
+        }
+
+        bool goodLoadFactor() const noexcept
+        {
+            return this->table.goodLoadFactor();
+        }
+
+        consts::LoadFactorStatus loadFactorStatus() const noexcept
+        {
+            return this->table.loadFactorStatus();
+        }
+
+        ConstIterator begin() const noexcept
+        {
+            return this->table.begin();
+        }
+
+        ConstIterator end() const noexcept
+        {
+            return this->table.end();
+        }
+
+        void clear() noexcept
+        {
+            this->table.clear();
+            this->index.clear();
+        }
+
+        // The values stay where they are, the index does not change.
+        bool reCapacity() noexcept(false)
+        {
+            return this->table.reCapacity();
+        }
+
+        void reserve(const consts::t_uIndex &count) noexcept(false)
+        {
+            this->table.reserve(count);
+            this->index.reserve(count);
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            const Tdata *old = this->dataOf(key);
+
+            if (old)
+            {
+                if (*old == data)
+                    return this->table.insert(key, data);
+
+                this->unlink(key, *old);
+            }
+
+            if (!this->table.insert(key, data))
+            {
+                // The old value is still in the table.
+                if (old)
+                    this->link(key, *this->dataOf(key));
+                return false;
+            }
+
+            this->link(key, data);
+            return true;
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            if (!this->table.add(key, data))
+                return false;
+
+            this->link(key, data);
+            return true;
+        }
+
+        bool erase(const Tkey &key) noexcept(false)
+        {
+            const Tdata *found = this->dataOf(key);
+
+            if (!found)
+                return false;
+
+            Tdata data = *found;
+
+            this->table.erase(key);
+            this->unlink(key, data);
+            return true;
+        }
+
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            const Tdata *found = this->dataOf(key);
+
+            if (!found)
+                return false;
+
+            Tdata data = *found;
+
+            this->table.remove(key);
+            this->unlink(key, data);
+            return true;
+        }
+
+        const Tdata *search(const Tkey &key) noexcept
+        {
+            return this->dataOf(key);
+        }
+
+        bool containsKey(const Tkey &key) noexcept
+        {
+            return this->table.containsKey(key);
+        }
+
+        bool contains(const Tdata &data) const
+        {
+            return this->index.containsKey(data);
+        }
+
+        // One of the keys that hold "data", nullptr if none does.
+        const Tkey *findKeyByValue(const Tdata &data) const noexcept
+        {
+            const typeNode::ValueKeys<Tkey> *entry = this->entryOf(data);
+
+            return entry ? &entry->key : nullptr;
+        }
+
+        // Number of the keys that hold "data".
+        consts::t_uIndex countValue(const Tdata &data) const noexcept
+        {
+            const typeNode::ValueKeys<Tkey> *entry = this->entryOf(data);
+
+            return entry ? entry->count : 0;
+        }
+
+        // Number of the distinct values.
+        consts::t_uIndex values() const noexcept
+        {
+            return this->index.size();
+        }
+
+        /**
+         * Memory of the reverse index in bytes, for an open addressing index: its slots and one
+         * control byte per slot. Memory the values own themselves (e.g. a long std::string) is
+         * allocated once more for the index and is not counted.
+         */
+        std::size_t indexBytes() const noexcept
+        {
+            return static_cast<std::size_t>(this->index.capacity()) * (sizeof(typename std::iterator_traits<typename Tindex::ConstIterator>::value_type) + sizeof(typeNode::consts::t_control));
+        }
+
+        // Of the table, the index is not counted.
+        Statistics statistics() const
+        {
+            return this->table.statistics();
+        }
+
+        std::string toString() const
+        {
+            return this->table.toString();
+        }
+    };
+}
+
+#endif
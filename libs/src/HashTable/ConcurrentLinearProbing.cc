@@ -0,0 +1,434 @@
+#ifndef __HashTable_ConcurrentLinearProbing_Class__
+#define __HashTable_ConcurrentLinearProbing_Class__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/Capacity.cc"
+#include "HashTable/policy/KeyEqual.cc"
+#include "HashTable/sync/Epoch.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        // State word of a slot: the status in the low bits, the version of the slot above them.
+        using t_slotState = unsigned int;
+
+        const t_slotState SLOT_EMPTY = 0;
+        const t_slotState SLOT_OCCUPIED = 1;
+        const t_slotState SLOT_TOMBSTONE = 2;
+        const t_slotState SLOT_BUSY = 3;
+        const t_slotState SLOT_STATUS_MASK = 3;
+        const t_slotState SLOT_VERSION_STEP = 4;
+    }
+
+    /**
+     * Linear probing for read-mostly workloads shared between threads: search and containsKey take
+     * no locks and write no shared memory, writers are serialized by one mutex.
+     *
+     * Every slot has a seqlock state word: a writer marks the slot busy, changes it and stores the
+     * new status with the next version. A reader copies the slot and takes the copy only if the
+     * state word did not change meanwhile, otherwise it reads the slot again. Keys never move within
+     * a slot array, so a probe that ends at an empty slot is a true miss. reCapacity fills a new
+     * array and publishes it with one pointer store; the old one is freed by the writer once no
+     * reader can hold it any more (sync::Epoch).
+     *
+     * A slot keeps its key and data as relaxed atomic 64-bit words, copied word by word on both
+     * sides: a reader that races a writer reads stale words, which the state word makes it throw
+     * away, never a torn non-atomic value. Keys and data must be trivially copyable.
+     */
+    template <class Tkey, class Tdata, class Tcapacity = policy::CapacityPowerOfTwo<Tkey>, class Tequal = policy::KeyEqual<Tkey>>
+    class ConcurrentLinearProbing
+    {
+        static_assert(std::is_trivially_copyable<Tkey>::value && std::is_trivially_copyable<Tdata>::value, "lock-free readers copy keys and data as bytes");
+
+    private:
+        struct Element
+        {
+            Tkey key;
+            Tdata data;
+        };
+
+        static constexpr std::size_t SLOT_WORDS = (sizeof(Element) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t) && alignof(std::atomic<std::uint64_t>) == alignof(std::uint64_t), "a slot word is laid out as a plain 64-bit word");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "readers load the slot words without locks");
+
+        // The element as atomic words: the stores of a writer and the loads of a reader never race.
+        struct Slot
+        {
+            std::atomic<std::uint64_t> words[SLOT_WORDS];
+
+            Element load() const noexcept
+            {
+                std::uint64_t buffer[SLOT_WORDS];
+                Element result;
+
+                for (std::size_t i = 0; i < SLOT_WORDS; ++i)
+                    buffer[i] = this->words[i].load(std::memory_order_relaxed);
+
+                std::memcpy(static_cast<void *>(&result), buffer, sizeof(Element));
+                return result;
+            }
+
+            void store(const Element &element) noexcept
+            {
+                std::uint64_t buffer[SLOT_WORDS] = {};
+
+                std::memcpy(buffer, static_cast<const void *>(&element), sizeof(Element));
+
+                for (std::size_t i = 0; i < SLOT_WORDS; ++i)
+                    this->words[i].store(buffer[i], std::memory_order_relaxed);
+            }
+        };
+
+        struct Array
+        {
+            Tcapacity capacityPolicy;
+            consts::t_uIndex capacity;
+            std::atomic<consts::t_slotState> *states;
+            Slot *slots;
+
+            Array(const consts::t_uIndex &capacity, const Tcapacity &capacityPolicy) : capacityPolicy(capacityPolicy), capacity(capacity), states(new std::atomic<consts::t_slotState>[capacity]), slots(new Slot[capacity])
+            {
+                this->capacityPolicy.resize(capacity);
+
+                for (consts::t_uIndex i = 0; i < capacity; ++i)
+                    states[i].store(consts::SLOT_EMPTY, std::memory_order_relaxed);
+            }
+
+            Array(const Array &other) = delete;
+            Array &operator=(const Array &other) = delete;
+
+            ~Array()
+            {
+                delete[] states;
+                delete[] slots;
+            }
+        };
+
+        std::atomic<Array *> current;
+        std::atomic<consts::t_uIndex> _size;
+        consts::t_uIndex tombstones;
+        consts::t_stat _loadFactorMin;
+        consts::t_stat _loadFactorMax;
+        Tequal keyEqual;
+
+        std::mutex writer;
+
+        // Arrays replaced by reCapacity with the epochs they were retired at, see sync::Epoch.
+        std::vector<std::pair<Array *, sync::consts::t_epoch>> retired;
+
+        static consts::t_slotState status(const consts::t_slotState &state) noexcept
+        {
+            return state & consts::SLOT_STATUS_MASK;
+        }
+
+        // Writer only. Index of the slot with the key or capacity if there is none.
+        consts::t_uIndex find(const Array &array, const consts::t_uHash &hash, const Tkey &key) const noexcept
+        {
+            consts::t_uIndex index = array.capacityPolicy.indexOf(hash);
+
+            for (consts::t_uIndex step = 0; step < array.capacity; ++step, index = array.capacityPolicy.next(index))
+            {
+                consts::t_slotState state = status(array.states[index].load(std::memory_order_relaxed));
+
+                if (state == consts::SLOT_EMPTY)
+                    break;
+
+                if (state == consts::SLOT_OCCUPIED && this->keyEqual(array.slots[index].load().key, key))
+                    return index;
+            }
+
+            return array.capacity;
+        }
+
+        // Writer only. First free slot of the probe sequence, the key must be absent.
+        consts::t_uIndex findFree(const Array &array, const consts::t_uHash &hash) const noexcept
+        {
+            consts::t_uIndex index = array.capacityPolicy.indexOf(hash);
+
+            while (status(array.states[index].load(std::memory_order_relaxed)) == consts::SLOT_OCCUPIED)
+                index = array.capacityPolicy.next(index);
+
+            return index;
+        }
+
+        // Seqlock write of a slot: readers that copy it meanwhile see another state word and read it again.
+        void write(Array &array, const consts::t_uIndex &index, const Tkey &key, const Tdata &data) noexcept
+        {
+            consts::t_slotState state = array.states[index].load(std::memory_order_relaxed);
+            consts::t_slotState version = state & ~consts::SLOT_STATUS_MASK;
+
+            array.states[index].store(version | consts::SLOT_BUSY, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            array.slots[index].store(Element{key, data});
+
+            array.states[index].store((version + consts::SLOT_VERSION_STEP) | consts::SLOT_OCCUPIED, std::memory_order_release);
+        }
+
+        void erase(Array &array, const consts::t_uIndex &index) noexcept
+        {
+            consts::t_slotState version = array.states[index].load(std::memory_order_relaxed) & ~consts::SLOT_STATUS_MASK;
+
+            array.states[index].store((version + consts::SLOT_VERSION_STEP) | consts::SLOT_TOMBSTONE, std::memory_order_release);
+        }
+
+        // Frees the retired arrays no reader can hold any more.
+        void collect() noexcept
+        {
+            std::size_t kept = 0;
+
+            for (std::pair<Array *, sync::consts::t_epoch> &item : this->retired)
+            {
+                if (sync::Epoch::safe(item.second))
+                    delete item.first;
+                else
+                    this->retired[kept++] = item;
+            }
+
+            this->retired.resize(kept);
+        }
+
+        // Writer only. The elements move to a new array of newCapacity slots, the tombstones are dropped.
+        void rebuild(consts::t_uIndex newCapacity) noexcept(false)
+        {
+            Array *array = this->current.load(std::memory_order_relaxed);
+
+            newCapacity = Tcapacity::round(newCapacity);
+
+            Array *result = new Array(newCapacity, array->capacityPolicy);
+
+            for (consts::t_uIndex i = 0; i < array->capacity; ++i)
+            {
+                if (status(array->states[i].load(std::memory_order_relaxed)) != consts::SLOT_OCCUPIED)
+                    continue;
+
+                Element element = array->slots[i].load();
+                consts::t_uIndex index = this->findFree(*result, result->capacityPolicy.hash(element.key));
+
+                result->slots[index].store(element);
+                result->states[index].store(consts::SLOT_OCCUPIED, std::memory_order_relaxed);
+            }
+
+            this->current.store(result, std::memory_order_seq_cst);
+            this->tombstones = 0;
+
+            this->retired.emplace_back(array, sync::Epoch::retire());
+            this->collect();
+        }
+
+        // Writer only, like LinearProbing::reCapacity: grows over the maximum load factor (tombstones
+        // included, they lengthen the probes), shrinks under the minimum.
+        void reCapacity(const consts::t_uIndex &size) noexcept(false)
+        {
+            Array *array = this->current.load(std::memory_order_relaxed);
+            consts::t_stat middle = (this->_loadFactorMin + this->_loadFactorMax) / 2;
+
+            if (size + this->tombstones > array->capacity * this->_loadFactorMax)
+                this->rebuild(size / middle + 1);
+            else if (array->capacity > consts::DEFAULT_CAPACITY && size < array->capacity * this->_loadFactorMin)
+                this->rebuild(size / middle + 1);
+        }
+
+        template <class Tfunction>
+        bool read(const Tkey &key, Tfunction found) const noexcept
+        {
+            sync::Epoch::Guard guard;
+
+            const Array *array = this->current.load(std::memory_order_seq_cst);
+            consts::t_uHash hash = array->capacityPolicy.hash(key);
+            consts::t_uIndex index = array->capacityPolicy.indexOf(hash);
+
+            for (consts::t_uIndex step = 0; step < array->capacity;)
+            {
+                consts::t_slotState state = array->states[index].load(std::memory_order_acquire);
+                consts::t_slotState slotStatus = status(state);
+
+                if (slotStatus == consts::SLOT_EMPTY)
+                    return false;
+
+                // A writer is in the middle of the slot, it leaves in a few stores unless it was preempted.
+                if (slotStatus == consts::SLOT_BUSY)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (slotStatus == consts::SLOT_OCCUPIED)
+                {
+                    Element copy = array->slots[index].load();
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                    // The slot changed while it was copied: read it again.
+                    if (array->states[index].load(std::memory_order_relaxed) != state)
+                        continue;
+
+                    if (this->keyEqual(copy.key, key))
+                    {
+                        found(copy.data);
+                        return true;
+                    }
+                }
+
+                index = array->capacityPolicy.next(index);
+                ++step;
+            }
+
+            return false;
+        }
+
+    public:
+        ConcurrentLinearProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax, const Tcapacity &capacityPolicy) : _size(0), tombstones(0), _loadFactorMin(loadFactorMin), _loadFactorMax(loadFactorMax)
+        {
+            if (loadFactorMax >= 1 || loadFactorMax <= 0 || loadFactorMin >= 1 || loadFactorMin <= 0 || loadFactorMin >= loadFactorMax)
+                throw std::out_of_range("0 < LoadFactorMin < LoadFactorMax < 1");
+
+            this->current.store(new Array(Tcapacity::round(capacity < 1 ? 1 : capacity), capacityPolicy), std::memory_order_relaxed);
+        }
+
+        ConcurrentLinearProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : ConcurrentLinearProbing(capacity, loadFactorMin, loadFactorMax, Tcapacity(Tcapacity::round(capacity < 1 ? 1 : capacity))) {}
+
+        ConcurrentLinearProbing(const consts::t_uIndex &capacity = consts::DEFAULT_CAPACITY) : ConcurrentLinearProbing(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        ConcurrentLinearProbing(const ConcurrentLinearProbing &other) = delete;
+        ConcurrentLinearProbing &operator=(const ConcurrentLinearProbing &other) = delete;
+
+        consts::t_uIndex size() const noexcept
+        {
+            return this->_size.load(std::memory_order_relaxed);
+        }
+
+        consts::t_uIndex capacity() const noexcept
+        {
+            sync::Epoch::Guard guard;
+            return this->current.load(std::memory_order_seq_cst)->capacity;
+        }
+
+        consts::t_stat loadFactor() const noexcept
+        {
+            return static_cast<consts::t_stat>(this->size()) / static_cast<consts::t_stat>(this->capacity());
+        }
+
+        // Lock-free: copies the data of the key into "data", false if there is no such key.
+        bool search(const Tkey &key, Tdata &data) const noexcept
+        {
+            return this->read(key, [&data](const Tdata &found) { data = found; });
+        }
+
+        // Lock-free.
+        bool containsKey(const Tkey &key) const noexcept
+        {
+            return this->read(key, [](const Tdata &) {});
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            std::lock_guard<std::mutex> lock(this->writer);
+            Array *array = this->current.load(std::memory_order_relaxed);
+            consts::t_uHash hash = array->capacityPolicy.hash(key);
+            consts::t_uIndex index = this->find(*array, hash, key);
+
+            if (index != array->capacity)
+            {
+                this->write(*array, index, key, data);
+                return true;
+            }
+
+            this->reCapacity(this->size() + 1);
+            array = this->current.load(std::memory_order_relaxed);
+            index = this->findFree(*array, hash);
+
+            this->tombstones -= status(array->states[index].load(std::memory_order_relaxed)) == consts::SLOT_TOMBSTONE;
+            this->write(*array, index, key, data);
+            this->_size.fetch_add(1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            std::lock_guard<std::mutex> lock(this->writer);
+            Array *array = this->current.load(std::memory_order_relaxed);
+            consts::t_uHash hash = array->capacityPolicy.hash(key);
+
+            if (this->find(*array, hash, key) != array->capacity)
+                return false;
+
+            this->reCapacity(this->size() + 1);
+            array = this->current.load(std::memory_order_relaxed);
+
+            consts::t_uIndex index = this->findFree(*array, hash);
+
+            this->tombstones -= status(array->states[index].load(std::memory_order_relaxed)) == consts::SLOT_TOMBSTONE;
+            this->write(*array, index, key, data);
+            this->_size.fetch_add(1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        // Leaves a tombstone, the capacity does not change.
+        bool erase(const Tkey &key) noexcept
+        {
+            std::lock_guard<std::mutex> lock(this->writer);
+            Array *array = this->current.load(std::memory_order_relaxed);
+            consts::t_uIndex index = this->find(*array, array->capacityPolicy.hash(key), key);
+
+            if (index == array->capacity)
+                return false;
+
+            this->erase(*array, index);
+            ++this->tombstones;
+            this->_size.fetch_sub(1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        // erase that shrinks the table under the minimum load factor.
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            if (!this->erase(key))
+                return false;
+
+            std::lock_guard<std::mutex> lock(this->writer);
+            this->reCapacity(this->size());
+
+            return true;
+        }
+
+        void clear() noexcept(false)
+        {
+            std::lock_guard<std::mutex> lock(this->writer);
+            Array *array = this->current.load(std::memory_order_relaxed);
+
+            this->current.store(new Array(Tcapacity::round(consts::DEFAULT_CAPACITY), array->capacityPolicy), std::memory_order_seq_cst);
+            this->_size.store(0, std::memory_order_relaxed);
+            this->tombstones = 0;
+
+            this->retired.emplace_back(array, sync::Epoch::retire());
+            this->collect();
+        }
+
+        // No reader may run during the destruction.
+        ~ConcurrentLinearProbing()
+        {
+            for (std::pair<Array *, sync::consts::t_epoch> &item : this->retired)
+                delete item.first;
+
+            delete this->current.load(std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef __HashTable_ConcurrentSharded_Class__
+#define __HashTable_ConcurrentSharded_Class__
+
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+#include "LinearProbing.cc"
+#include "HashFunctions/FunctionFibonacci.cc"
+#include "HashFunctions/FunctionMurmur.cc"
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/Capacity.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        const t_uIndex CONCURRENT_DEFAULT_SHARDS = 64;
+    }
+
+    /**
+     * Thread-safe table: the keys are split between a power of two number of independent shard
+     * tables, every shard has its own lock and grows and shrinks by itself. Operations on keys
+     * of different shards do not wait for each other.
+     *
+     * @tparam Ttable shard table: LinearProbing, LinearProbingChainMethod or any table with the same interface.
+     * Its search must not change the table, it runs under a shared lock.
+     * @tparam Thash full-width hash function that picks the shard. Its result goes through the murmur
+     * finalizer and the shard is taken from the high bits of that, so the keys of one shard stay
+     * spread over all the slots of the shard even when the shard table uses the same hash function.
+     * @tparam Tlock std::shared_mutex (readers of a shard run in parallel) or sync::SpinLock.
+     *
+     * search copies the data out: a pointer into a shard would outlive the lock. update changes the
+     * data in place under the lock. size/capacity/loadFactor lock the shards one after another,
+     * with concurrent writers they are not a snapshot of one moment.
+     */
+    template <class Tkey, class Tdata, class Ttable = LinearProbing<Tkey, Tdata, policy::CapacityPowerOfTwo<Tkey>>, class Thash = HashFunctions::FunctionFibonacci<Tkey>, class Tlock = std::shared_mutex>
+    class ConcurrentSharded
+    {
+    private:
+        // Every shard on its own cache lines: the lock of one shard is not invalidated by the writers of another.
+        struct alignas(64) Shard
+        {
+            mutable Tlock lock;
+            Ttable table;
+
+            explicit Shard(const Ttable &table) : table(table) {}
+        };
+
+        Shard *shards;
+        consts::t_uIndex shardCount;
+        Thash hashFunction;
+        HashFunctions::FunctionMurmur<consts::t_uHash> mix;
+
+        static consts::t_uIndex roundShards(const consts::t_uIndex &shards) noexcept
+        {
+            consts::t_uIndex result = 1;
+
+            while (result < shards)
+                result <<= 1;
+
+            return result;
+        }
+
+        Shard &shard(const Tkey &key) const noexcept
+        {
+            consts::t_uHash hash = this->mix.hash(this->hashFunction.hash(key));
+
+            return shards[static_cast<consts::t_uIndex>(hash >> 32) & (this->shardCount - 1)];
+        }
+
+    public:
+        /**
+         * @param shards number of shards, rounded up to a power of two. A few times the number of
+         * threads keeps the chance that two threads need the same shard low.
+         * @param table every shard starts as a copy of it: capacity, load factors, policies.
+         */
+        explicit ConcurrentSharded(const consts::t_uIndex &shards = consts::CONCURRENT_DEFAULT_SHARDS, const Ttable &table = Ttable(), const Thash &hashFunction = Thash()) : shardCount(roundShards(shards)), hashFunction(hashFunction)
+        {
+            this->shards = static_cast<Shard *>(::operator new(sizeof(Shard) * this->shardCount, std::align_val_t(alignof(Shard))));
+
+            consts::t_uIndex i = 0;
+
+            try
+            {
+                for (; i < this->shardCount; ++i)
+                    new (&this->shards[i]) Shard(table);
+            }
+            catch (...)
+            {
+                // The destructor does not run for a constructor that throws: undo the shards made so far.
+                while (i)
+                    this->shards[--i].~Shard();
+
+                ::operator delete(this->shards, std::align_val_t(alignof(Shard)));
+                throw;
+            }
+        }
+
+        ConcurrentSharded(const ConcurrentSharded &other) = delete;
+        ConcurrentSharded &operator=(const ConcurrentSharded &other) = delete;
+
+        consts::t_uIndex getShardCount() const noexcept
+        {
+            return this->shardCount;
+        }
+
+        consts::t_uIndex size() const
+        {
+            consts::t_uIndex result = 0;
+
+            for (consts::t_uIndex i = 0; i < this->shardCount; ++i)
+            {
+                std::shared_lock<Tlock> guard(shards[i].lock);
+                result += shards[i].table.size();
+            }
+
+            return result;
+        }
+
+        consts::t_uIndex capacity() const
+        {
+            consts::t_uIndex result = 0;
+
+            for (consts::t_uIndex i = 0; i < this->shardCount; ++i)
+            {
+                std::shared_lock<Tlock> guard(shards[i].lock);
+                result += shards[i].table.capacity();
+            }
+
+            return result;
+        }
+
+        // Load factor of all the shards together.
+        consts::t_stat loadFactor() const
+        {
+            consts::t_uIndex size = 0;
+            consts::t_uIndex capacity = 0;
+
+            for (consts::t_uIndex i = 0; i < this->shardCount; ++i)
+            {
+                std::shared_lock<Tlock> guard(shards[i].lock);
+                size += shards[i].table.size();
+                capacity += shards[i].table.capacity();
+            }
+
+            if (capacity == 0)
+                return 1;
+            return static_cast<consts::t_stat>(size) / static_cast<consts::t_stat>(capacity);
+        }
+
+        void clear()
+        {
+            for (consts::t_uIndex i = 0; i < this->shardCount; ++i)
+            {
+                std::unique_lock<Tlock> guard(shards[i].lock);
+                shards[i].table.clear();
+            }
+        }
+
+        bool insert(const Tkey &key, const Tdata &data)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            return shard.table.insert(key, data);
+        }
+
+        bool insert(Tkey &&key, Tdata &&data)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            return shard.table.insert(std::move(key), std::move(data));
+        }
+
+        bool add(const Tkey &key, const Tdata &data)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            return shard.table.add(key, data);
+        }
+
+        bool add(Tkey &&key, Tdata &&data)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            return shard.table.add(std::move(key), std::move(data));
+        }
+
+        bool erase(const Tkey &key)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            return shard.table.erase(key);
+        }
+
+        bool remove(const Tkey &key)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            return shard.table.remove(key);
+        }
+
+        // Copies the data of the key into "data", false if there is no such key.
+        bool search(const Tkey &key, Tdata &data) const
+        {
+            Shard &shard = this->shard(key);
+            std::shared_lock<Tlock> guard(shard.lock);
+
+            auto found = shard.table.search(key);
+
+            if (!found)
+                return false;
+
+            if constexpr (std::is_same<decltype(found), Tdata *>::value)
+                data = *found;
+            else
+                data = found->data;
+
+            return true;
+        }
+
+        bool containsKey(const Tkey &key) const
+        {
+            Shard &shard = this->shard(key);
+            std::shared_lock<Tlock> guard(shard.lock);
+
+            return shard.table.containsKey(key);
+        }
+
+        // Calls function(Tdata &) on the data of the key under the lock of its shard, false if there is no such key.
+        template <class Tfunction>
+        bool update(const Tkey &key, Tfunction function)
+        {
+            Shard &shard = this->shard(key);
+            std::unique_lock<Tlock> guard(shard.lock);
+
+            auto found = shard.table.search(key);
+
+            if (!found)
+                return false;
+
+            if constexpr (std::is_same<decltype(found), Tdata *>::value)
+                function(*found);
+            else
+                function(found->data);
+
+            return true;
+        }
+
+        ~ConcurrentSharded()
+        {
+            for (consts::t_uIndex i = 0; i < this->shardCount; ++i)
+                this->shards[i].~Shard();
+
+            ::operator delete(this->shards, std::align_val_t(alignof(Shard)));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,543 @@
+#ifndef __HashTable_CuckooHashing_Class__
+#define __HashTable_CuckooHashing_Class__
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "HashFunctions/FunctionMurmur.cc"
+#include "HashFunctions/FunctionSplitMix.cc"
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/KeyEqual.cc"
+#include "HashTable/policy/Transparent.cc"
+#include "HashTable/typeNode/OpenAddressingFlat.cc"
+#include "HashTable/typeNode/SlotIterator.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        // Slots of a bucket.
+        const t_uIndex CUCKOO_BUCKET_SIZE = 4;
+
+        // Buckets an insert may visit looking for a way to free a slot, about 4 moves deep. A table
+        // where that is not enough is treated as having a cycle and grows.
+        const t_uIndex CUCKOO_MAX_SEARCH = 512;
+
+        // Seed of the second hash function when it takes one, so two functions of one type differ.
+        const t_uHash CUCKOO_SECOND_SEED = 0x9E3779B97F4A7C15ull;
+    }
+
+    /**
+     * Bucketized cuckoo hashing: every key may be only in one of two buckets of CUCKOO_BUCKET_SIZE
+     * slots, chosen by two independent hash functions, so a lookup reads at most 8 slots (two cache
+     * lines for small elements) whatever the load. Control bytes keep a 7-bit fingerprint of the
+     * key, most slots are skipped without a key compare.
+     *
+     * An insert into two full buckets finds, breadth-first, the shortest chain of elements to move to
+     * their other buckets that ends at a free slot, and moves them from the end. When there is no such
+     * chain within CUCKOO_MAX_SEARCH buckets the table doubles. Loads up to about 0.95 are reachable.
+     *
+     * @tparam Thash1, Thash2 hash functions from HashFunctions, they must be independent. Thash2 is
+     * constructed with CUCKOO_SECOND_SEED when it takes a seed, so the same seeded type (e.g.
+     * FunctionWyhash for strings) can be used for both.
+     *
+     * Like the other tables it does not derive from HashTableInterface, InterfaceAdapter implements
+     * the interface over it.
+     */
+    template <class Tkey, class Tdata, class Thash1 = HashFunctions::FunctionMurmur<Tkey>, class Thash2 = HashFunctions::FunctionSplitMix<Tkey>, class Tequal = policy::KeyEqual<Tkey>>
+    class CuckooHashing : public HashTableBase<Tkey, Tdata>
+    {
+    private:
+        // A bucket reached by the search for a free slot: through the element in "slot" of the bucket of "parent".
+        struct Step
+        {
+            consts::t_uIndex bucket;
+            consts::t_uIndex parent;
+            consts::t_uIndex slot;
+        };
+
+        Thash1 hashFunction1;
+        Thash2 hashFunction2;
+        Tequal keyEqual;
+        typeNode::OpenAddressingFlat<Tkey, Tdata> table;
+
+        // Lookups by a key of another type are enabled when both hash functions are transparent, see policy/Transparent.cc.
+        template <class Tother>
+        using enableLookup = typename std::enable_if<policy::isTransparent<Thash2>::value, policy::enableTransparent<Tkey, Tother, Thash1, Tequal>>::type;
+
+        template <class Thash>
+        static Thash seeded(const consts::t_uHash &seed)
+        {
+            if constexpr (std::is_constructible<Thash, consts::t_uHash>::value)
+                return Thash(seed);
+            else
+                return Thash();
+        }
+
+        static consts::t_uIndex round(const consts::t_uIndex &capacity) noexcept
+        {
+            consts::t_uIndex buckets = (capacity + consts::CUCKOO_BUCKET_SIZE - 1) / consts::CUCKOO_BUCKET_SIZE;
+
+            return (buckets ? buckets : 1) * consts::CUCKOO_BUCKET_SIZE;
+        }
+
+        consts::t_uIndex buckets() const noexcept
+        {
+            return this->capacity() / consts::CUCKOO_BUCKET_SIZE;
+        }
+
+        // High 32 bits of the hash scaled to [0, buckets) by a multiply and a shift, without a division.
+        consts::t_uIndex bucketOf(const consts::t_uHash &hash) const noexcept
+        {
+            return static_cast<consts::t_uIndex>(((hash >> 32) * this->buckets()) >> 32);
+        }
+
+        static typeNode::consts::t_control fingerprint(const consts::t_uHash &hash) noexcept
+        {
+            return static_cast<typeNode::consts::t_control>(hash & 0x7F);
+        }
+
+        template <class Tk>
+        consts::t_uIndex findIn(const consts::t_uIndex &bucket, const typeNode::consts::t_control &tag, const Tk &key) const noexcept
+        {
+            consts::t_uIndex first = bucket * consts::CUCKOO_BUCKET_SIZE;
+
+            for (consts::t_uIndex index = first; index < first + consts::CUCKOO_BUCKET_SIZE; ++index)
+            {
+                if (table.getControl(index) == tag && this->keyEqual(table.getKey(index), key))
+                    return index;
+            }
+
+            return this->capacity();
+        }
+
+        template <class Tk>
+        consts::t_uIndex find(const Tk &key) const noexcept
+        {
+            if (!table.allocated())
+                return this->capacity();
+
+            consts::t_uHash hash = this->hashFunction1.hash(key);
+            consts::t_uIndex second = this->bucketOf(this->hashFunction2.hash(key));
+
+            // Both buckets are read from memory at once.
+            table.prefetch(second * consts::CUCKOO_BUCKET_SIZE);
+
+            consts::t_uIndex index = this->findIn(this->bucketOf(hash), fingerprint(hash), key);
+
+            if (index != this->capacity())
+                return index;
+
+            return this->findIn(second, fingerprint(hash), key);
+        }
+
+        consts::t_uIndex freeSlot(const consts::t_uIndex &bucket) const noexcept
+        {
+            consts::t_uIndex first = bucket * consts::CUCKOO_BUCKET_SIZE;
+
+            for (consts::t_uIndex index = first; index < first + consts::CUCKOO_BUCKET_SIZE; ++index)
+            {
+                if (!table.isOccupied(index))
+                    return index;
+            }
+
+            return this->capacity();
+        }
+
+        // The other bucket of the key stored in "bucket".
+        consts::t_uIndex alternate(const Tkey &key, const consts::t_uIndex &bucket) const noexcept
+        {
+            consts::t_uIndex first = this->bucketOf(this->hashFunction1.hash(key));
+
+            return first == bucket ? this->bucketOf(this->hashFunction2.hash(key)) : first;
+        }
+
+        // Whether the bucket is on the chain from the step to the bucket of the new key.
+        static bool onPath(const Step *steps, consts::t_uIndex step, const consts::t_uIndex &bucket) noexcept
+        {
+            for (; step != consts::CUCKOO_MAX_SEARCH; step = steps[step].parent)
+            {
+                if (steps[step].bucket == bucket)
+                    return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * Breadth-first search from the two full buckets of a new key for a bucket with a free slot.
+         * A bucket appears at most once on a chain, so every move lands in a bucket of the moved key.
+         * Frees a slot in "first" or "second" by moving the chain from its end and returns the slot,
+         * capacity() if there is no chain within CUCKOO_MAX_SEARCH buckets.
+         */
+        consts::t_uIndex makeRoom(const consts::t_uIndex &first, const consts::t_uIndex &second) noexcept
+        {
+            Step steps[consts::CUCKOO_MAX_SEARCH];
+            consts::t_uIndex count = 0;
+
+            steps[count++] = {first, consts::CUCKOO_MAX_SEARCH, 0};
+
+            if (second != first)
+                steps[count++] = {second, consts::CUCKOO_MAX_SEARCH, 0};
+
+            for (consts::t_uIndex current = 0; current < count; ++current)
+            {
+                for (consts::t_uIndex slot = 0; slot < consts::CUCKOO_BUCKET_SIZE; ++slot)
+                {
+                    consts::t_uIndex bucket = this->alternate(table.getKey(steps[current].bucket * consts::CUCKOO_BUCKET_SIZE + slot), steps[current].bucket);
+
+                    if (onPath(steps, current, bucket))
+                        continue;
+
+                    if (count == consts::CUCKOO_MAX_SEARCH)
+                        return this->capacity();
+
+                    steps[count] = {bucket, current, slot};
+
+                    consts::t_uIndex free = this->freeSlot(bucket);
+
+                    if (free != this->capacity())
+                        return this->shift(steps, count, free);
+
+                    ++count;
+                }
+            }
+
+            return this->capacity();
+        }
+
+        // Moves every element of the chain into the slot freed after it, returns the slot freed in the first bucket.
+        consts::t_uIndex shift(const Step *steps, consts::t_uIndex step, consts::t_uIndex free) noexcept
+        {
+            while (steps[step].parent != consts::CUCKOO_MAX_SEARCH)
+            {
+                consts::t_uIndex from = steps[steps[step].parent].bucket * consts::CUCKOO_BUCKET_SIZE + steps[step].slot;
+
+                table.relocate(free, from, table.getControl(from));
+                free = from;
+                step = steps[step].parent;
+            }
+
+            return free;
+        }
+
+        // The key must be absent. Grows the table when it is full or no slot can be freed for the key.
+        template <class Tk, class Td>
+        void place(Tk &&key, Td &&data) noexcept(false)
+        {
+            while (true)
+            {
+                if (this->size() == this->capacity())
+                    this->grow();
+
+                consts::t_uHash hash = this->hashFunction1.hash(key);
+                consts::t_uIndex first = this->bucketOf(hash);
+                consts::t_uIndex second = this->bucketOf(this->hashFunction2.hash(key));
+                consts::t_uIndex index = this->freeSlot(first);
+
+                if (index == this->capacity())
+                    index = this->freeSlot(second);
+
+                if (index == this->capacity())
+                    index = this->makeRoom(first, second);
+
+                if (index != this->capacity())
+                {
+                    table.set(index, std::forward<Tk>(key), std::forward<Td>(data), fingerprint(hash));
+                    ++this->_size;
+                    return;
+                }
+
+                this->grow();
+            }
+        }
+
+        template <class Tk, class Td>
+        bool insertValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            consts::t_uIndex index = this->find(key);
+
+            if (index != this->capacity())
+            {
+                table.setData(index, std::forward<Td>(data));
+                return true;
+            }
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            this->place(std::forward<Tk>(key), std::forward<Td>(data));
+            return true;
+        }
+
+        template <class Tk, class Td>
+        bool addValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            if (this->find(key) != this->capacity())
+                return false;
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            this->place(std::forward<Tk>(key), std::forward<Td>(data));
+            return true;
+        }
+
+        template <class Tk>
+        bool eraseKey(const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(key);
+
+            if (index == this->capacity())
+                return false;
+
+            // No probe sequence runs through a slot, so no tombstone is needed.
+            table.erase(index, typeNode::consts::CONTROL_EMPTY);
+            --this->_size;
+            return true;
+        }
+
+        template <class Tk>
+        bool removeKey(const Tk &key) noexcept(false)
+        {
+            if (!this->eraseKey(key))
+                return false;
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk>
+        Tdata *searchKey(const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(key);
+
+            if (index == this->capacity())
+                return nullptr;
+
+            return &table.getData(index);
+        }
+
+        void rebuild(const consts::t_uIndex &newCapacity) noexcept(false)
+        {
+            CuckooHashing tmp(newCapacity, this->getLoadFactorMin(), this->getLoadFactorMax(), this->hashFunction1, this->hashFunction2);
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (table.isOccupied(i))
+                    tmp.place(std::move(table.getKey(i)), std::move(table.getData(i)));
+            }
+
+            this->_capacity = tmp.capacity();
+            tmp.table.swap(this->table);
+        }
+
+        void grow() noexcept(false)
+        {
+            this->rebuild(this->capacity() < consts::CUCKOO_BUCKET_SIZE ? consts::CUCKOO_BUCKET_SIZE : 2 * this->capacity());
+        }
+
+    public:
+        CuckooHashing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax, const Thash1 &hashFunction1, const Thash2 &hashFunction2) : HashTableBase<Tkey, Tdata>(round(capacity), loadFactorMin, loadFactorMax), hashFunction1(hashFunction1), hashFunction2(hashFunction2), table(round(capacity)) {}
+
+        CuckooHashing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : CuckooHashing(capacity, loadFactorMin, loadFactorMax, Thash1(), seeded<Thash2>(consts::CUCKOO_SECOND_SEED)) {}
+
+        CuckooHashing(const consts::t_uIndex &capacity) : CuckooHashing(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        CuckooHashing() : CuckooHashing(consts::DEFAULT_CAPACITY, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        CuckooHashing(const CuckooHashing &other) : CuckooHashing(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax(), other.hashFunction1, other.hashFunction2)
+        {
+            this->_growth = other._growth;
+
+            for (consts::t_uIndex i = 0; i < other.capacity(); ++i)
+            {
+                if (other.table.isOccupied(i))
+                    this->place(other.table.getKey(i), other.table.getData(i));
+            }
+        }
+
+        void clear() noexcept
+        {
+            table.clear();
+            this->_capacity = 0;
+            this->_size = 0;
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->insertValue(key, data);
+        }
+
+        bool insert(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->insertValue(std::move(key), std::move(data));
+        }
+
+        bool erase(const Tkey &key) noexcept
+        {
+            return this->eraseKey(key);
+        }
+
+        // erase by a key of another type, e.g. std::string_view for std::string keys.
+        template <class Tother, class = enableLookup<Tother>>
+        bool erase(const Tother &key) noexcept
+        {
+            return this->eraseKey(key);
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->addValue(key, data);
+        }
+
+        bool add(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->addValue(std::move(key), std::move(data));
+        }
+
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool remove(const Tother &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
+
+        Tdata *search(const Tkey &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        // search by a key of another type, e.g. std::string_view for std::string keys: no Tkey is built.
+        template <class Tother, class = enableLookup<Tother>>
+        Tdata *search(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        bool containsKey(const Tkey &key) noexcept
+        {
+            return this->find(key) != this->capacity();
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool containsKey(const Tother &key) noexcept
+        {
+            return this->find(key) != this->capacity();
+        }
+
+        bool contains(const Tdata &data) const
+        {
+            if (!table.allocated())
+                return false;
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (table.isOccupied(i) && table.getData(i) == data)
+                    return true;
+            }
+            return false;
+        }
+
+        // Forward iterators over the elements, each is a Slot with key and data, see typeNode::SlotIterator.
+        using Iterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata>, false>;
+        using ConstIterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata>, true>;
+
+        Iterator begin() noexcept
+        {
+            return Iterator(&table, nullptr);
+        }
+
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(&table, nullptr);
+        }
+
+        Iterator end() noexcept
+        {
+            return Iterator();
+        }
+
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator();
+        }
+
+        bool reCapacity() noexcept(false)
+        {
+            consts::t_uIndex newCapacity;
+
+            switch (this->loadFactorStatus())
+            {
+            case consts::LoadFactorStatus::ZERO_CAPACITY_AND_ZERO_SIZE:
+
+                newCapacity = round(consts::DEFAULT_CAPACITY);
+
+                typeNode::OpenAddressingFlat<Tkey, Tdata>(newCapacity).swap(this->table);
+                this->_capacity = newCapacity;
+                return true;
+
+            case consts::LoadFactorStatus::GREATER_MAX:
+                newCapacity = round(this->grownCapacity());
+                break;
+
+            case consts::LoadFactorStatus::LESS_MIN:
+                newCapacity = round(this->shrunkCapacity());
+
+                // The rounding left no smaller capacity within the load factors, see policy::Growth.
+                if (!this->shrinksTo(newCapacity))
+                    return false;
+                break;
+
+            default:
+                return false;
+            }
+
+            this->rebuild(newCapacity);
+
+            return true;
+        }
+
+        std::string toString() const
+        {
+            std::string result;
+
+            result += "CuckooTable: {\n";
+
+            if (table.allocated())
+            {
+                for (consts::t_uIndex i = 0, j = 0; i < this->capacity(); ++i)
+                {
+                    if (table.isOccupied(i))
+                    {
+                        result += "\t" + tools::toString(table.getKey(i));
+
+                        result += " : ";
+
+                        result += tools::toString(table.getData(i));
+
+                        if (j < this->size() - 1)
+                        {
+                            result += ",\n";
+                            ++j;
+                        }
+                    }
+                }
+            }
+
+            result += "\n};";
+            return result;
+        }
+
+        ~CuckooHashing() {}
+    };
+}
+
+#endif
@@ -0,0 +1,495 @@
+#ifndef __HashTable_GroupProbing_Class__
+#define __HashTable_GroupProbing_Class__
+
+#include <string>
+#include <utility>
+
+#include "HashFunctions/FunctionFibonacci.cc"
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/KeyEqual.cc"
+#include "HashTable/policy/Transparent.cc"
+#include "HashTable/typeNode/OpenAddressingFlat.cc"
+#include "HashTable/typeNode/ControlGroup.cc"
+#include "HashTable/typeNode/SlotIterator.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        const t_stat GROUP_PROBING_LOAD_FACTOR_MAX = 0.875;
+    }
+
+    /**
+     * Open addressing over groups of 16 slots (Swiss table). Every occupied slot keeps a 7-bit
+     * fingerprint of the key hash in its control byte, a whole group of control bytes is compared
+     * with one SIMD instruction and keys are compared only when fingerprints match.
+     *
+     * The capacity is always a power of two number of groups, groups are visited in triangular order.
+     */
+    template <class Tkey, class Tdata, class Thash = HashFunctions::FunctionFibonacci<Tkey>, class Tequal = policy::KeyEqual<Tkey>>
+    class GroupProbing : public HashTableBase<Tkey, Tdata>
+    {
+    private:
+        Thash hashFunction;
+        Tequal keyEqual;
+        typeNode::OpenAddressingFlat<Tkey, Tdata> table;
+
+        consts::t_uIndex groupMask;
+        consts::t_uIndex groupShift;
+        consts::t_uIndex tombstones;
+
+        static consts::t_uIndex roundCapacity(const consts::t_uIndex &capacity) noexcept
+        {
+            consts::t_uIndex result = typeNode::consts::GROUP_SIZE;
+
+            while (result < capacity)
+                result <<= 1;
+
+            return result;
+        }
+
+        void setCapacity(const consts::t_uIndex &capacity) noexcept
+        {
+            consts::t_uIndex groupBits = 0;
+
+            while ((typeNode::consts::GROUP_SIZE << groupBits) < capacity)
+                ++groupBits;
+
+            this->_capacity = capacity;
+            this->groupMask = (1u << groupBits) - 1;
+            this->groupShift = 57 - groupBits;
+        }
+
+        // Lookups by a key of another type are enabled for a transparent Thash, see policy/Transparent.cc.
+        template <class Tother>
+        using enableLookup = policy::enableTransparent<Tkey, Tother, Thash, Tequal>;
+
+        template <class Tk>
+        HashFunctions::consts::t_uHash hash(const Tk &key) const noexcept
+        {
+            return this->hashFunction.hash(key);
+        }
+
+        // Fingerprint from the highest 7 bits, group from the bits right below them.
+        static typeNode::consts::t_control fingerprint(const HashFunctions::consts::t_uHash &hash) noexcept
+        {
+            return static_cast<typeNode::consts::t_control>(hash >> 57);
+        }
+
+        consts::t_uIndex homeGroup(const HashFunctions::consts::t_uHash &hash) const noexcept
+        {
+            return static_cast<consts::t_uIndex>(hash >> this->groupShift) & this->groupMask;
+        }
+
+        template <class Tk>
+        consts::t_uIndex find(const Tk &key, const HashFunctions::consts::t_uHash &hash) const noexcept
+        {
+            if (!table.allocated())
+                return this->capacity();
+
+            typeNode::consts::t_control control = fingerprint(hash);
+            consts::t_uIndex group = this->homeGroup(hash);
+
+            for (consts::t_uIndex step = 1; step <= this->groupMask + 1; ++step)
+            {
+                consts::t_uIndex first = group * typeNode::consts::GROUP_SIZE;
+                typeNode::ControlGroup controls(table.getControls() + first);
+
+                for (typeNode::consts::t_bitMask match = controls.match(control); match; match &= match - 1)
+                {
+                    consts::t_uIndex index = first + typeNode::ControlGroup::lowestBit(match);
+
+                    if (this->keyEqual(table.getKey(index), key))
+                        return index;
+                }
+
+                if (controls.matchEmpty())
+                    return this->capacity();
+
+                group = (group + step) & this->groupMask;
+            }
+
+            return this->capacity();
+        }
+
+        consts::t_uIndex findFree(const HashFunctions::consts::t_uHash &hash) const noexcept
+        {
+            if (!table.allocated())
+                return this->capacity();
+
+            consts::t_uIndex group = this->homeGroup(hash);
+
+            for (consts::t_uIndex step = 1; step <= this->groupMask + 1; ++step)
+            {
+                consts::t_uIndex first = group * typeNode::consts::GROUP_SIZE;
+                typeNode::consts::t_bitMask match = typeNode::ControlGroup(table.getControls() + first).matchFree();
+
+                if (match)
+                    return first + typeNode::ControlGroup::lowestBit(match);
+
+                group = (group + step) & this->groupMask;
+            }
+
+            return this->capacity();
+        }
+
+        template <class Tk, class Td>
+        bool set(Tk &&key, Td &&data, const HashFunctions::consts::t_uHash &hash) noexcept(false)
+        {
+            consts::t_uIndex index = this->findFree(hash);
+
+            if (index == this->capacity())
+                return false;
+
+            if (table.isTombstone(index))
+                --this->tombstones;
+
+            table.set(index, std::forward<Tk>(key), std::forward<Td>(data), fingerprint(hash));
+            ++this->_size;
+
+            return true;
+        }
+
+        void unset(const consts::t_uIndex &index) noexcept
+        {
+            // A group that still has an empty slot never made a probe sequence go past it,
+            // so the slot can be made empty instead of a tombstone.
+            consts::t_uIndex first = index - index % typeNode::consts::GROUP_SIZE;
+
+            if (typeNode::ControlGroup(table.getControls() + first).matchEmpty())
+            {
+                table.erase(index, typeNode::consts::CONTROL_EMPTY);
+            }
+            else
+            {
+                table.erase(index);
+                ++this->tombstones;
+            }
+
+            --this->_size;
+        }
+
+        template <class Tk, class Td>
+        bool insertValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            HashFunctions::consts::t_uHash hash = this->hash(key);
+            consts::t_uIndex index = this->find(key, hash);
+
+            if (index != this->capacity())
+            {
+                table.setData(index, std::forward<Td>(data));
+                return true;
+            }
+
+            if (!this->set(std::forward<Tk>(key), std::forward<Td>(data), hash))
+                return false;
+
+            if (this->overloaded())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk, class Td>
+        bool addValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            HashFunctions::consts::t_uHash hash = this->hash(key);
+
+            if (this->find(key, hash) != this->capacity())
+                return false;
+
+            if (!this->set(std::forward<Tk>(key), std::forward<Td>(data), hash))
+                return false;
+
+            if (this->overloaded())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk>
+        bool eraseKey(const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(key, this->hash(key));
+
+            if (index == this->capacity())
+                return false;
+
+            this->unset(index);
+            return true;
+        }
+
+        template <class Tk>
+        bool removeKey(const Tk &key) noexcept(false)
+        {
+            if (!this->eraseKey(key))
+                return false;
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk>
+        Tdata *searchKey(const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(key, this->hash(key));
+
+            if (index == this->capacity())
+                return nullptr;
+
+            return &table.getData(index);
+        }
+
+        bool overloaded() const noexcept
+        {
+            return this->size() + this->tombstones > this->capacity() * this->getLoadFactorMax();
+        }
+
+    public:
+        GroupProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : HashTableBase<Tkey, Tdata>(roundCapacity(capacity), loadFactorMin, loadFactorMax), table(roundCapacity(capacity)), tombstones(0)
+        {
+            this->setCapacity(this->capacity());
+        }
+
+        GroupProbing(const consts::t_uIndex &capacity) : GroupProbing(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::GROUP_PROBING_LOAD_FACTOR_MAX) {}
+
+        GroupProbing() : GroupProbing(typeNode::consts::GROUP_SIZE, consts::DEFAULT_LOAD_FACTOR_MIN, consts::GROUP_PROBING_LOAD_FACTOR_MAX) {}
+
+        GroupProbing(const GroupProbing &other) : GroupProbing(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax())
+        {
+            this->_growth = other._growth;
+
+            for (consts::t_uIndex i = 0; i < other.capacity(); ++i)
+            {
+                if (other.table.isOccupied(i))
+                    this->insert(other.table.getKey(i), other.table.getData(i));
+            }
+        }
+
+        void clear() noexcept
+        {
+            table.clear();
+            this->setCapacity(0);
+            this->_size = 0;
+            this->tombstones = 0;
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->insertValue(key, data);
+        }
+
+        bool insert(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->insertValue(std::move(key), std::move(data));
+        }
+
+        bool erase(const Tkey &key) noexcept
+        {
+            return this->eraseKey(key);
+        }
+
+        // erase by a key of another type, e.g. std::string_view for std::string keys.
+        template <class Tother, class = enableLookup<Tother>>
+        bool erase(const Tother &key) noexcept
+        {
+            return this->eraseKey(key);
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->addValue(key, data);
+        }
+
+        bool add(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->addValue(std::move(key), std::move(data));
+        }
+
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool remove(const Tother &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
+
+        Tdata *search(const Tkey &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        // search by a key of another type, e.g. std::string_view for std::string keys: no Tkey is built.
+        template <class Tother, class = enableLookup<Tother>>
+        Tdata *search(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        bool containsKey(const Tkey &key) noexcept
+        {
+            return this->find(key, this->hash(key)) != this->capacity();
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool containsKey(const Tother &key) noexcept
+        {
+            return this->find(key, this->hash(key)) != this->capacity();
+        }
+
+        bool contains(const Tdata &data) const
+        {
+            if (!table.allocated())
+                return false;
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (table.isOccupied(i) && table.getData(i) == data)
+                    return true;
+            }
+            return false;
+        }
+
+        // Forward iterators over the elements, each is a Slot with key and data, see typeNode::SlotIterator.
+        using Iterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata>, false>;
+        using ConstIterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata>, true>;
+
+        Iterator begin() noexcept
+        {
+            return Iterator(&table, nullptr);
+        }
+
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(&table, nullptr);
+        }
+
+        Iterator end() noexcept
+        {
+            return Iterator();
+        }
+
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator();
+        }
+
+        // The counters with the tombstones and the bytes of the slot array.
+        Statistics statistics() const
+        {
+            Statistics result = HashTableBase<Tkey, Tdata>::statistics();
+
+            if (!this->counting())
+                return result;
+
+            result.tombstones = this->tombstones;
+            result.bytesAllocated = static_cast<unsigned long long>(this->capacity()) * (sizeof(typename typeNode::OpenAddressingFlat<Tkey, Tdata>::Slot) + sizeof(typeNode::consts::t_control));
+
+            return result;
+        }
+
+        bool reCapacity() noexcept(false)
+        {
+            consts::t_uIndex newCapacity;
+
+            switch (this->loadFactorStatus())
+            {
+            case consts::LoadFactorStatus::ZERO_CAPACITY_AND_ZERO_SIZE:
+
+                typeNode::OpenAddressingFlat<Tkey, Tdata>(typeNode::consts::GROUP_SIZE).swap(this->table);
+                this->setCapacity(typeNode::consts::GROUP_SIZE);
+                this->tombstones = 0;
+                return true;
+
+            case consts::LoadFactorStatus::GREATER_MAX:
+                newCapacity = roundCapacity(this->grownCapacity());
+                break;
+
+            case consts::LoadFactorStatus::LESS_MIN:
+                newCapacity = roundCapacity(this->shrunkCapacity());
+
+                // The rounding left no smaller capacity within the load factors, see policy::Growth.
+                if (!this->shrinksTo(newCapacity))
+                    return false;
+                break;
+
+            default:
+                if (!this->overloaded())
+                    return false;
+
+                // Tombstones pushed the table over the limit: rebuild in place,
+                // or grow if the table is dense enough to stay above the shrink threshold after doubling.
+                newCapacity = this->capacity();
+                if (this->size() >= 2 * this->capacity() * this->shrinkLoadFactor() && 4 * this->size() >= 3 * this->capacity() * this->getLoadFactorMax())
+                    newCapacity *= 2;
+                break;
+            }
+
+            if (newCapacity == this->capacity() && !this->tombstones)
+                return false;
+
+            GroupProbing tmp(newCapacity, this->getLoadFactorMin(), this->getLoadFactorMax());
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (!table.isOccupied(i))
+                    continue;
+
+                HashFunctions::consts::t_uHash hash = this->hash(table.getKey(i));
+                tmp.set(std::move(table.getKey(i)), std::move(table.getData(i)), hash);
+            }
+
+            this->setCapacity(newCapacity);
+            this->tombstones = 0;
+            tmp.table.swap(this->table);
+
+            return true;
+        }
+
+        std::string toString() const
+        {
+            std::string result;
+
+            result += "GroupProbingTable: {\n";
+
+            if (table.allocated())
+            {
+                for (consts::t_uIndex i = 0, j = 0; i < this->capacity(); ++i)
+                {
+                    if (table.isOccupied(i))
+                    {
+                        result += "\t" + tools::toString(table.getKey(i));
+
+                        result += " : ";
+
+                        result += tools::toString(table.getData(i));
+
+                        if (j < this->size() - 1)
+                        {
+                            result += ",\n";
+                            ++j;
+                        }
+                    }
+                }
+            }
+
+            result += "\n};";
+            return result;
+        }
+
+        ~GroupProbing() {}
+    };
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef __HashFunctions_FunctionFibonacci_Class__
+#define __HashFunctions_FunctionFibonacci_Class__
+
+#include <string>
+#include <string_view>
+
+#include "HashFunction.cc"
+
+namespace HashFunctions
+{
+    namespace consts
+    {
+        using t_uHash = unsigned long long;
+
+        // 2^64 / golden ratio
+        const t_uHash FIBONACCI_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+    }
+
+    /**
+     * Full-width multiplicative (Fibonacci) hash. The result is not reduced to a table size:
+     * the high bits are the well mixed ones, so a table takes its index and fingerprint from them.
+     */
+    template <class Tkey>
+    class FunctionFibonacci : public HashFunction<Tkey, consts::t_uHash>
+    {
+    public:
+        consts::t_uHash hash(const Tkey &key) const override;
+
+        virtual ~FunctionFibonacci(){};
+    };
+
+    /**
+     * Strings: FNV-1a spread by the multiplication. Transparent: a std::string_view or a C string
+     * hashes the same as the equal std::string, lookups by them need no temporary string.
+     */
+    template <>
+    class FunctionFibonacci<std::string> : public HashFunction<std::string, consts::t_uHash>
+    {
+    public:
+        using is_transparent = void;
+
+        consts::t_uHash hash(const std::string &key) const override
+        {
+            return this->hash(std::string_view(key));
+        }
+
+        consts::t_uHash hash(std::string_view key) const noexcept
+        {
+            // FNV-1a
+            consts::t_uHash sum = 0xCBF29CE484222325ull;
+
+            for (char c : key)
+            {
+                sum ^= static_cast<unsigned char>(c);
+                sum *= 0x100000001B3ull;
+            }
+
+            return sum * consts::FIBONACCI_MULTIPLIER;
+        }
+
+        consts::t_uHash hash(const char *key) const noexcept
+        {
+            return this->hash(std::string_view(key));
+        }
+
+        virtual ~FunctionFibonacci(){};
+    };
+
+    template <class Tkey>
+    consts::t_uHash FunctionFibonacci<Tkey>::hash(const Tkey &key) const
+    {
+        return static_cast<consts::t_uHash>(key) * consts::FIBONACCI_MULTIPLIER;
+    }
+}
+
+#endif
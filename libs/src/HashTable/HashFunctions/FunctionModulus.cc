@@ -2,6 +2,8 @@
 #define __HashFunctions_FunctionModulus_Class__
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "HashFunction.cc"
 
@@ -10,6 +12,7 @@ namespace HashFunctions
     namespace consts
     {
         using t_uIndex = unsigned int;
+        using t_uHash = unsigned long long;
     }
 
     template <class Tkey>
@@ -26,7 +29,13 @@ namespace HashFunctions
             return this->size;
         }
 
-        consts::t_uIndex hash(const Tkey &key) const override;
+        consts::t_uIndex hash(const Tkey &key) const override
+        {
+            return static_cast<consts::t_uIndex>(this->unreduced(key) % this->getSize());
+        }
+
+        // The hash before it is reduced to the size, as wide as the key: a 64-bit key is reduced in 64 bits.
+        consts::t_uHash unreduced(const Tkey &key) const;
 
         void resize(const consts::t_uIndex &newSize) noexcept
         {
@@ -36,22 +45,68 @@ namespace HashFunctions
         virtual ~FunctionModulus(){};
     };
 
+    /**
+     * Strings: the sum of the characters weighted by their positions. Transparent: a std::string_view
+     * or a C string hashes the same as the equal std::string, lookups by them need no temporary string.
+     */
     template <>
-    consts::t_uIndex FunctionModulus<std::string>::hash(const std::string &key) const
+    class FunctionModulus<std::string> : public HashFunction<std::string, consts::t_uIndex>
     {
-        consts::t_uIndex sum = 0;
-        consts::t_uIndex index = 1;
 
-        for (char c : key)
-            sum += index++ * static_cast<int>(c);
+        consts::t_uIndex size;
 
-        return sum % this->getSize();
-    }
+    public:
+        using is_transparent = void;
+
+        FunctionModulus(const consts::t_uIndex &size) : size(size) {}
+
+        consts::t_uIndex getSize() const noexcept
+        {
+            return this->size;
+        }
+
+        consts::t_uIndex hash(const std::string &key) const override
+        {
+            return static_cast<consts::t_uIndex>(this->unreduced(key) % this->getSize());
+        }
+
+        consts::t_uIndex hash(std::string_view key) const noexcept
+        {
+            return static_cast<consts::t_uIndex>(this->unreduced(key) % this->getSize());
+        }
+
+        consts::t_uIndex hash(const char *key) const noexcept
+        {
+            return this->hash(std::string_view(key));
+        }
+
+        consts::t_uHash unreduced(std::string_view key) const noexcept
+        {
+            consts::t_uIndex sum = 0;
+            consts::t_uIndex index = 1;
+
+            for (char c : key)
+                sum += index++ * static_cast<int>(c);
+
+            return sum;
+        }
+
+        void resize(const consts::t_uIndex &newSize) noexcept
+        {
+            this->size = newSize;
+        }
+
+        virtual ~FunctionModulus(){};
+    };
 
     template <class Tkey>
-    consts::t_uIndex FunctionModulus<Tkey>::hash(const Tkey &key) const
+    consts::t_uHash FunctionModulus<Tkey>::unreduced(const Tkey &key) const
     {
-        return key % this->getSize();
+        // Signed keys are taken as unsigned of the same width: a negative key wider than the size
+        // would give a negative remainder.
+        using Tunsigned = typename std::conditional<std::is_integral<Tkey>::value && std::is_signed<Tkey>::value, std::make_unsigned<Tkey>, std::common_type<Tkey>>::type::type;
+
+        return static_cast<Tunsigned>(key);
     }
 
 }
@@ -0,0 +1,40 @@
+#ifndef __HashFunctions_FunctionMurmur_Class__
+#define __HashFunctions_FunctionMurmur_Class__
+
+#include <type_traits>
+
+#include "HashFunction.cc"
+#include "FunctionFibonacci.cc"
+
+namespace HashFunctions
+{
+    /**
+     * Full-width integer hash: the MurmurHash3 finalizer (fmix64) over the key xor a seed.
+     */
+    template <class Tkey>
+    class FunctionMurmur : public HashFunction<Tkey, consts::t_uHash>
+    {
+        static_assert(std::is_integral<Tkey>::value, "FunctionMurmur hashes integer keys");
+
+        consts::t_uHash seed;
+
+    public:
+        explicit FunctionMurmur(const consts::t_uHash &seed = 0) : seed(seed) {}
+
+        consts::t_uHash hash(const Tkey &key) const override
+        {
+            consts::t_uHash result = static_cast<consts::t_uHash>(key) ^ this->seed;
+
+            result ^= result >> 33;
+            result *= 0xFF51AFD7ED558CCDull;
+            result ^= result >> 33;
+            result *= 0xC4CEB9FE1A85EC53ull;
+
+            return result ^ (result >> 33);
+        }
+
+        virtual ~FunctionMurmur(){};
+    };
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __HashFunctions_FunctionSplitMix_Class__
+#define __HashFunctions_FunctionSplitMix_Class__
+
+#include <type_traits>
+
+#include "HashFunction.cc"
+#include "FunctionFibonacci.cc"
+
+namespace HashFunctions
+{
+    /**
+     * Full-width integer hash: the splitmix64 finalizer over the key plus a seed.
+     * Every bit of the key reaches every bit of the result, so strided keys and dense runs
+     * of keys spread over the whole table.
+     */
+    template <class Tkey>
+    class FunctionSplitMix : public HashFunction<Tkey, consts::t_uHash>
+    {
+        static_assert(std::is_integral<Tkey>::value, "FunctionSplitMix hashes integer keys");
+
+        consts::t_uHash seed;
+
+    public:
+        explicit FunctionSplitMix(const consts::t_uHash &seed = 0) : seed(seed) {}
+
+        consts::t_uHash hash(const Tkey &key) const override
+        {
+            consts::t_uHash result = static_cast<consts::t_uHash>(key) + this->seed + consts::FIBONACCI_MULTIPLIER;
+
+            result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+            result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+
+            return result ^ (result >> 31);
+        }
+
+        virtual ~FunctionSplitMix(){};
+    };
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef __HashFunctions_FunctionWyhash_Class__
+#define __HashFunctions_FunctionWyhash_Class__
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "HashFunction.cc"
+#include "FunctionFibonacci.cc"
+
+namespace HashFunctions
+{
+    namespace consts
+    {
+        const t_uHash WYHASH_SECRET[4] = {0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull};
+    }
+
+    /**
+     * Full-width string hash of the wyhash family: reads 8 bytes per step and mixes them with
+     * 64x64->128 bit multiplications. Keys longer than 48 bytes are processed in three
+     * independent lanes, so the multiplications of a step overlap in the pipeline.
+     *
+     * Use it with a full-width capacity policy, e.g. policy::CapacityPowerOfTwo<std::string, FunctionWyhash>.
+     * Transparent: a std::string_view or a C string hashes the same as the equal std::string.
+     */
+    class FunctionWyhash : public HashFunction<std::string, consts::t_uHash>
+    {
+    private:
+        consts::t_uHash seed;
+
+        static consts::t_uHash mix(const consts::t_uHash &a, const consts::t_uHash &b) noexcept
+        {
+            unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+
+            return static_cast<consts::t_uHash>(product) ^ static_cast<consts::t_uHash>(product >> 64);
+        }
+
+        static consts::t_uHash read8(const unsigned char *bytes) noexcept
+        {
+            consts::t_uHash result;
+            std::memcpy(&result, bytes, 8);
+            return result;
+        }
+
+        static consts::t_uHash read4(const unsigned char *bytes) noexcept
+        {
+            unsigned int result;
+            std::memcpy(&result, bytes, 4);
+            return result;
+        }
+
+    public:
+        using is_transparent = void;
+
+        explicit FunctionWyhash(const consts::t_uHash &seed = 0) : seed(seed) {}
+
+        consts::t_uHash hash(const std::string &key) const override
+        {
+            return hash(key.data(), key.size());
+        }
+
+        consts::t_uHash hash(std::string_view key) const noexcept
+        {
+            return hash(key.data(), key.size());
+        }
+
+        consts::t_uHash hash(const char *key) const noexcept
+        {
+            return hash(std::string_view(key));
+        }
+
+        consts::t_uHash hash(const char *key, const consts::t_uHash &length) const noexcept
+        {
+            const consts::t_uHash *secret = consts::WYHASH_SECRET;
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(key);
+
+            consts::t_uHash state = this->seed ^ mix(this->seed ^ secret[0], secret[1]);
+            consts::t_uHash a, b;
+
+            if (length <= 16)
+            {
+                if (length >= 4)
+                {
+                    consts::t_uHash middle = (length >> 3) << 2;
+
+                    a = (read4(bytes) << 32) | read4(bytes + middle);
+                    b = (read4(bytes + length - 4) << 32) | read4(bytes + length - 4 - middle);
+                }
+                else if (length > 0)
+                {
+                    a = (static_cast<consts::t_uHash>(bytes[0]) << 16) | (static_cast<consts::t_uHash>(bytes[length >> 1]) << 8) | bytes[length - 1];
+                    b = 0;
+                }
+                else
+                {
+                    a = b = 0;
+                }
+            }
+            else
+            {
+                consts::t_uHash rest = length;
+
+                if (rest > 48)
+                {
+                    consts::t_uHash lane1 = state, lane2 = state;
+
+                    do
+                    {
+                        state = mix(read8(bytes) ^ secret[1], read8(bytes + 8) ^ state);
+                        lane1 = mix(read8(bytes + 16) ^ secret[2], read8(bytes + 24) ^ lane1);
+                        lane2 = mix(read8(bytes + 32) ^ secret[3], read8(bytes + 40) ^ lane2);
+
+                        bytes += 48;
+                        rest -= 48;
+                    } while (rest > 48);
+
+                    state ^= lane1 ^ lane2;
+                }
+
+                while (rest > 16)
+                {
+                    state = mix(read8(bytes) ^ secret[1], read8(bytes + 8) ^ state);
+
+                    bytes += 16;
+                    rest -= 16;
+                }
+
+                a = read8(bytes + rest - 16);
+                b = read8(bytes + rest - 8);
+            }
+
+            a ^= secret[1];
+            b ^= state;
+
+            unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<consts::t_uHash>(product);
+            b = static_cast<consts::t_uHash>(product >> 64);
+
+            return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+        }
+
+        virtual ~FunctionWyhash(){};
+    };
+}
+
+#endif
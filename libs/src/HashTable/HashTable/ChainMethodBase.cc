@@ -1,91 +1,293 @@
 #ifndef __HashTable_ChainMethodBase_Interface__
 #define __HashTable_ChainMethodBase_Interface__
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <type_traits>
+#include <utility>
 
-#include "HashTableInterface.cc"
+#include "HashTableBase.cc"
+#include "policy/KeyEqual.cc"
+#include "policy/NodeAllocator.cc"
 #include "typeNode/Chain.cc"
+#include "typeNode/UnrolledBucket.cc"
 
 namespace HashTable
 {
-    template <class Tkey, class Tdata>
-    class ChainMethodBase : public HashTableInterface<Tkey, Tdata>
+    // The element functions take the bucket index and the full hash of the key, see typeNode::Chain.
+    // The buckets are Tbucket: typeNode::Chain (a linked list of nodes) or typeNode::UnrolledBucket
+    // (elements stored in cache-line blocks). What they allocate comes from one Tallocator of the
+    // table, see policy/NodeAllocator.cc.
+    template <class Tkey, class Tdata, class Tequal = policy::KeyEqual<Tkey>, bool cacheHash = false, template <class> class Tallocator = policy::AllocatorNew,
+              template <class, class, class, bool> class Tbucket = typeNode::Chain>
+    class ChainMethodBase : public HashTableBase<Tkey, Tdata>
     {
     public:
-        void clear() noexcept override
+        using Bucket = Tbucket<Tkey, Tdata, Tequal, cacheHash>;
+        using Node = typename Bucket::Node;
+
+        /**
+         * Forward iterator over the elements, bucket by bucket, each is a Node with key and data. Any
+         * change of the table invalidates it; with UnrolledBucket the elements move on remove too.
+         */
+        template <bool isConst>
+        class BasicIterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Node;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<isConst, const Node *, Node *>::type;
+            using reference = typename std::conditional<isConst, const Node &, Node &>::type;
+
+        private:
+            const Bucket *table;
+            consts::t_uIndex capacity;
+            consts::t_uIndex index;
+            typename Bucket::Iterator item;
+
+            // Moves to the first element from the current one on, past empty buckets.
+            void settle() noexcept
+            {
+                while (this->index < this->capacity && !(this->item != this->table[this->index].end()))
+                {
+                    if (++this->index < this->capacity)
+                        this->item = this->table[this->index].begin();
+                }
+            }
+
+        public:
+            BasicIterator(const Bucket *table, const consts::t_uIndex &capacity, const consts::t_uIndex &index) noexcept : table(table), capacity(capacity), index(index), item(index < capacity ? table[index].begin() : nullptr)
+            {
+                this->settle();
+            }
+
+            // A const iterator from an iterator.
+            template <bool otherConst, class = typename std::enable_if<isConst && !otherConst>::type>
+            BasicIterator(const BasicIterator<otherConst> &other) noexcept : table(other.table), capacity(other.capacity), index(other.index), item(other.item) {}
+
+            reference operator*() const noexcept
+            {
+                return *this->item;
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &*this->item;
+            }
+
+            BasicIterator &operator++() noexcept
+            {
+                ++this->item;
+                this->settle();
+                return *this;
+            }
+
+            BasicIterator operator++(int) noexcept
+            {
+                BasicIterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const BasicIterator &other) const noexcept
+            {
+                return this->index == other.index && !(this->item != other.item);
+            }
+
+            bool operator!=(const BasicIterator &other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+            template <bool>
+            friend class BasicIterator;
+        };
+
+        using Iterator = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+
+        Iterator begin() noexcept
+        {
+            return Iterator(table, this->capacity(), 0);
+        }
+
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(table, this->capacity(), 0);
+        }
+
+        Iterator end() noexcept
+        {
+            return Iterator(table, this->capacity(), this->capacity());
+        }
+
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator(table, this->capacity(), this->capacity());
+        }
+
+        // With an allocator that frees all the nodes at once and nodes without destructors it takes O(blocks).
+        void clear() noexcept
         {
             if (table)
             {
+                // Otherwise the nodes are destroyed one by one.
+                if constexpr (!Tallocator<typename Bucket::Allocated>::releasesAll || !std::is_trivially_destructible<Node>::value)
+                {
+                    for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+                        table[i].clear(allocator);
+                }
+
+                allocator.release();
                 delete[] table;
 
                 table = nullptr;
             }
+
+            // Without buckets: the next add or insert makes them again.
+            this->_size = 0;
+            this->_capacity = 0;
         }
 
-        std::string toString() const override;
+        // The counters with the longest bucket and the bytes of the buckets and the elements, without the allocator overhead.
+        Statistics statistics() const
+        {
+            Statistics result = HashTableBase<Tkey, Tdata>::statistics();
+
+            if (!this->counting())
+                return result;
+
+            for (consts::t_uIndex i = 0; table && i < this->capacity(); ++i)
+                result.maxChain = std::max<consts::t_uIndex>(result.maxChain, table[i].size());
+
+            result.bytesAllocated = static_cast<unsigned long long>(this->capacity()) * sizeof(Bucket) + static_cast<unsigned long long>(this->size()) * sizeof(Node);
+
+            return result;
+        }
+
+        std::string toString() const;
 
     protected:
+        Bucket *table;
+        Tallocator<typename Bucket::Allocated> allocator;
 
-        HashTable::typeNode::Chain<Tkey, Tdata> *table;
-        
-        ChainMethodBase(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : HashTableInterface<Tkey, Tdata>(capacity, loadFactorMin, loadFactorMax), table(nullptr)
+        ChainMethodBase(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : HashTableBase<Tkey, Tdata>(capacity, loadFactorMin, loadFactorMax), table(nullptr)
         {
             if (this->capacity())
             {
-                table = new typeNode::Chain<Tkey, Tdata>[this->capacity()];
+                table = new Bucket[this->capacity()];
             }
         }
 
-        bool insert(const consts::t_uIndex &hashIndex, const Tkey &key, const Tdata &data) noexcept
+        // Batch operations prefetch in two passes: the buckets of all the keys, then what their
+        // lookups read next (the first node, the first overflow block), found by the first pass.
+        void prefetchBucket(const consts::t_uIndex &hashIndex) const noexcept
+        {
+            if (hashIndex < this->capacity())
+                __builtin_prefetch(table + hashIndex);
+        }
+
+        void prefetchChain(const consts::t_uIndex &hashIndex) const noexcept
+        {
+            if (hashIndex < this->capacity())
+                table[hashIndex].prefetch();
+        }
+
+        template <class Tk, class Td>
+        bool insert(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
         {
             if(hashIndex >= this->capacity()) return false;
 
-            if(table[hashIndex].size() == 0)
-                ++this->_size;
+            this->countProbes(Statistics::INSERT, table[hashIndex].size());
 
-            table[hashIndex].insert(key, data);
+            this->_size += table[hashIndex].insert(allocator, hash, std::forward<Tk>(key), std::forward<Td>(data));
             return true;
         }
 
-        bool erase(const consts::t_uIndex &hashIndex, const Tkey &key) noexcept
+        // The key must be absent, see typeNode::Chain::place.
+        template <class Tk, class Td>
+        void place(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
         {
-            if(hashIndex >= this->capacity()) return false;
+            table[hashIndex].place(allocator, hash, std::forward<Tk>(key), std::forward<Td>(data));
+            ++this->_size;
+        }
+
+        // Moves the elements to newCapacity new buckets, index(node) is the bucket of an element among
+        // them. A Chain relinks its nodes; an UnrolledBucket moves its elements, the allocator stays the same.
+        template <class Tindex>
+        void rebuild(const consts::t_uIndex &newCapacity, Tindex index) noexcept(false)
+        {
+            typename HashTableBase<Tkey, Tdata>::ReCapacityTimer timer(*this);
+            Bucket *buckets = new Bucket[newCapacity];
 
-            return table[hashIndex].remove(key);
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+                table[i].moveTo(allocator, buckets, index);
+
+            delete[] table;
+            table = buckets;
+            this->_capacity = newCapacity;
         }
 
-        bool add(const consts::t_uIndex &hashIndex, const Tkey &key, const Tdata &data) noexcept
+        // Node of the key and whether it was added now, see typeNode::Chain::emplace. {nullptr, false} without buckets.
+        template <class Tk, class... Targs>
+        std::pair<Node *, bool> tryEmplace(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, Tk &&key, Targs &&...args) noexcept(false)
         {
-            if(hashIndex >= this->capacity()) return false;
+            if(hashIndex >= this->capacity()) return {nullptr, false};
 
-            if(table[hashIndex].size() == 0)
-                ++this->_size;
+            this->countProbes(Statistics::INSERT, table[hashIndex].size());
 
-            return table[hashIndex].add(key, data);
+            std::pair<Node *, bool> result = table[hashIndex].emplace(allocator, hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+
+            this->_size += result.second;
+            return result;
         }
 
-        bool remove(const consts::t_uIndex &hashIndex, const Tkey &key) noexcept
+        template <class Tk>
+        bool erase(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, const Tk &key) noexcept
         {
             if(hashIndex >= this->capacity()) return false;
 
-            return table[hashIndex].remove(key);
+            this->countProbes(Statistics::ERASE, table[hashIndex].size());
+
+            if(!table[hashIndex].remove(allocator, hash, key)) return false;
+
+            --this->_size;
+            return true;
+        }
+
+        template <class Tk, class Td>
+        bool add(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
+        {
+            return this->tryEmplace(hashIndex, hash, std::forward<Tk>(key), std::forward<Td>(data)).second;
         }
 
-        typename typeNode::Chain<Tkey, Tdata>::Node* search(const consts::t_uIndex &hashIndex, const Tkey &key) noexcept
+        template <class Tk>
+        bool remove(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, const Tk &key) noexcept(false)
+        {
+            return this->erase(hashIndex, hash, key);
+        }
+
+        template <class Tk>
+        Node* search(const consts::t_uIndex &hashIndex, const consts::t_uHash &hash, const Tk &key) noexcept
         {
             if(hashIndex >= this->capacity()) return nullptr;
 
-            return table[hashIndex].getByKey(key);
+            this->countProbes(Statistics::SEARCH, table[hashIndex].size());
+
+            return table[hashIndex].getByKey(hash, key);
         }
 
-        virtual ~ChainMethodBase()
+        ~ChainMethodBase()
         {
             this->clear();
         }
     };
 
-    template <class Tkey, class Tdata>
-    std::string ChainMethodBase<Tkey, Tdata>::toString() const
+    template <class Tkey, class Tdata, class Tequal, bool cacheHash, template <class> class Tallocator, template <class, class, class, bool> class Tbucket>
+    std::string ChainMethodBase<Tkey, Tdata, Tequal, cacheHash, Tallocator, Tbucket>::toString() const
     {
         std::string result;
 
@@ -0,0 +1,518 @@
+#ifndef __HashTable_HashTableBase_Class__
+#define __HashTable_HashTableBase_Class__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace HashTable
+{
+    namespace consts
+    {
+        using t_stat = float;
+        using t_uIndex = unsigned int;
+        using t_uHash = unsigned long long;
+
+        const t_stat DEFAULT_LOAD_FACTOR_MIN = 0.25;
+        const t_stat DEFAULT_LOAD_FACTOR_MAX = 0.75;
+        const t_uIndex DEFAULT_CAPACITY = 3;
+
+        // Incremental rehash: the fewest slots of the old array moved by one operation, and the bytes
+        // of the new array prepared by one operation before the move starts.
+        const t_uIndex INCREMENTAL_REHASH_STEP = 4;
+        const t_uIndex INCREMENTAL_REHASH_CLEAR = 1 << 14;
+
+        // Moved slots of the old array given back to the system at once during an incremental rehash.
+        const t_uIndex INCREMENTAL_REHASH_RELEASE = 4096;
+
+        // Keys of a batch operation hashed and prefetched before their probes run.
+        const t_uIndex BATCH_SIZE = 16;
+
+        // An overloaded table grows this many times, see policy::Growth.
+        const t_stat DEFAULT_GROWTH_FACTOR = 2;
+
+        // A table shrinks when its load factor is below loadFactorMin times this, see policy::Growth.
+        const t_stat DEFAULT_SHRINK_HYSTERESIS = 0.5;
+
+        // Entries of a probe length histogram of Statistics, the last one counts the longer probes too.
+        const t_uIndex STATISTICS_PROBE_LENGTHS = 16;
+
+        enum LoadFactorStatus
+        {
+            GREATER_MAX,
+            LESS_MIN,
+            ZERO_CAPACITY_AND_ZERO_SIZE,
+            NOT_ZERO_CAPACITY_AND_ZERO_SIZE,
+            ALL_GOOD
+        };
+
+        template <class T>
+        void swap(T &arg1, T &arg2)
+        {
+            T tmp = arg1;
+            arg1 = arg2;
+            arg2 = tmp;
+        }
+    }
+
+    namespace tools
+    {
+        inline std::string toString(const std::string &value)
+        {
+            return value;
+        }
+
+        template <class T>
+        std::string toString(const T &value)
+        {
+            return std::to_string(value);
+        }
+
+        // Kind of a key or data type in the type tag of the binary forms, with its size it tells an
+        // int from a float: 1 bool, 2 unsigned integer, 3 signed integer, 4 floating point, 5 std::string,
+        // 0 any other type.
+        template <class T>
+        constexpr std::uint32_t typeKind() noexcept
+        {
+            if (std::is_same<T, bool>::value)
+                return 1;
+            if (std::is_integral<T>::value)
+                return std::is_unsigned<T>::value ? 2 : 3;
+            if (std::is_floating_point<T>::value)
+                return 4;
+            if (std::is_same<T, std::string>::value)
+                return 5;
+            return 0;
+        }
+    }
+
+    namespace policy
+    {
+        /**
+         * How reCapacity resizes a table. A table over loadFactorMax grows geometrically, "factor"
+         * times. A table shrinks, to the middle of the load factors, only when its load factor falls
+         * below loadFactorMin * shrinkHysteresis: the band between the two keeps add/remove workloads
+         * around loadFactorMin from rebuilding the table on every turn. shrinkHysteresis = 0 never shrinks.
+         *
+         * A grown table is kept above the shrink threshold, and a shrink that the rounding of the
+         * capacity would push over loadFactorMax is not done.
+         */
+        struct Growth
+        {
+            consts::t_stat factor;
+            consts::t_stat shrinkHysteresis;
+
+            static Growth geometric(const consts::t_stat factor = consts::DEFAULT_GROWTH_FACTOR, const consts::t_stat shrinkHysteresis = consts::DEFAULT_SHRINK_HYSTERESIS) noexcept
+            {
+                return {factor, shrinkHysteresis};
+            }
+
+            static Growth neverShrink(const consts::t_stat factor = consts::DEFAULT_GROWTH_FACTOR) noexcept
+            {
+                return {factor, 0};
+            }
+        };
+    }
+
+    /**
+     * Counters of a table, counted only with HASHTABLE_STATISTICS defined: without it the tables
+     * allocate no counters, their operations do not touch them and statistics() returns all zeros
+     * (see HashTableBase::CountersPointer).
+     *
+     * probes[operation][n] - operations that looked at n slots (LinearProbing) or at a bucket of n
+     * elements (LinearProbingChainMethod), n >= STATISTICS_PROBE_LENGTHS - 1 in the last entry.
+     * reCapacities, reCapacityNanoseconds - rebuilds of the table for a new capacity and their time.
+     * maxChain, tombstones, bytesAllocated - state of the table when statistics() was called.
+     *
+     * LinearProbing and LinearProbingChainMethod fill them all in, GroupProbing the tombstones and
+     * bytesAllocated. RobinHoodProbing and CuckooHashing count no probes; they leave no tombstones,
+     * so their zero there is exact.
+     *
+     * The tables keep the probe counters as relaxed atomics (see HashTableBase::ProbeCounters): lookups
+     * that run in parallel under a shared lock (ConcurrentSharded) count without a data race, and
+     * statistics() reads them one by one, not as a snapshot of one moment.
+     */
+    struct Statistics
+    {
+        enum Operation
+        {
+            INSERT,
+            SEARCH,
+            ERASE,
+            OPERATIONS
+        };
+
+        unsigned long long probes[OPERATIONS][consts::STATISTICS_PROBE_LENGTHS] = {};
+        unsigned long long reCapacities = 0;
+        unsigned long long reCapacityNanoseconds = 0;
+        consts::t_uIndex maxChain = 0;
+        consts::t_uIndex tombstones = 0;
+        unsigned long long bytesAllocated = 0;
+
+        void countProbes(const Operation &operation, const consts::t_uIndex &length) noexcept
+        {
+            ++this->probes[operation][std::min(length, consts::STATISTICS_PROBE_LENGTHS - 1)];
+        }
+
+        // Mean probe length of the operation, the lengths of the last entry taken as its lower bound.
+        double meanProbes(const Operation &operation) const noexcept
+        {
+            unsigned long long count = 0;
+            double sum = 0;
+
+            for (consts::t_uIndex length = 0; length < consts::STATISTICS_PROBE_LENGTHS; ++length)
+            {
+                count += this->probes[operation][length];
+                sum += static_cast<double>(this->probes[operation][length]) * length;
+            }
+
+            return count ? sum / count : 0;
+        }
+
+        std::string toJson() const
+        {
+            const char *names[OPERATIONS] = {"insert", "search", "erase"};
+            std::string result = "{\"probes\":{";
+
+            for (int operation = 0; operation < OPERATIONS; ++operation)
+            {
+                result += std::string(operation ? ",\"" : "\"") + names[operation] + "\":[";
+
+                for (consts::t_uIndex length = 0; length < consts::STATISTICS_PROBE_LENGTHS; ++length)
+                    result += (length ? "," : "") + std::to_string(this->probes[operation][length]);
+
+                result += "]";
+            }
+
+            result += "},\"reCapacities\":" + std::to_string(this->reCapacities);
+            result += ",\"reCapacityNanoseconds\":" + std::to_string(this->reCapacityNanoseconds);
+            result += ",\"maxChain\":" + std::to_string(this->maxChain);
+            result += ",\"tombstones\":" + std::to_string(this->tombstones);
+            result += ",\"bytesAllocated\":" + std::to_string(this->bytesAllocated);
+
+            return result + "}";
+        }
+    };
+
+    /**
+     * State and load factor bookkeeping shared by all tables. It has no virtual functions, so calls
+     * on a table are resolved at compile time and inlined. When a virtual interface is needed,
+     * InterfaceAdapter implements HashTableInterface over a table.
+     */
+    template <class Tkey, class Tdata>
+    class HashTableBase
+    {
+    public:
+        using t_key = Tkey;
+        using t_data = Tdata;
+
+        consts::t_uIndex size() const noexcept
+        {
+            return _size;
+        }
+
+        consts::t_uIndex capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        consts::t_stat getLoadFactorMin() const noexcept
+        {
+            return _loadFactorMin;
+        }
+
+        consts::t_stat getLoadFactorMax() const noexcept
+        {
+            return _loadFactorMax;
+        }
+
+        consts::t_stat setLoadFactorMin(consts::t_stat newLoadFactorMin) noexcept(false)
+        {
+            if (newLoadFactorMin >= 1 || newLoadFactorMin < 0)
+                throw std::out_of_range("LoadFactorMax must be less than 1, greater than or equal to 0");
+
+            if (this->_loadFactorMax == newLoadFactorMin)
+                throw std::invalid_argument("LoadFactorMin must be cannot be equal or greater LoadFactorMax");
+
+            this->_loadFactorMin = newLoadFactorMin;
+            return this->_loadFactorMin;
+        }
+
+        consts::t_stat setLoadFactorMax(consts::t_stat newLoadFactorMax) noexcept(false)
+        {
+            if (newLoadFactorMax > 1 || newLoadFactorMax <= 0)
+                throw std::out_of_range("LoadFactorMax must be less than or equal to 1, greater than 0");
+
+            if (this->_loadFactorMin >= newLoadFactorMax)
+                throw std::invalid_argument("LoadFactorMax must be cannot be equal or greater LoadFactorMin");
+
+            this->_loadFactorMax = newLoadFactorMax;
+            return this->_loadFactorMax;
+        }
+
+        policy::Growth getGrowth() const noexcept
+        {
+            return _growth;
+        }
+
+        policy::Growth setGrowth(const policy::Growth &newGrowth) noexcept(false)
+        {
+            if (!(newGrowth.factor > 1))
+                throw std::out_of_range("Growth factor must be greater than 1");
+
+            if (newGrowth.shrinkHysteresis < 0 || newGrowth.shrinkHysteresis > 1)
+                throw std::out_of_range("Shrink hysteresis must be less than or equal to 1, greater than or equal to 0");
+
+            this->_growth = newGrowth;
+            return this->_growth;
+        }
+
+        consts::t_stat loadFactor() const
+        {
+            if (this->_capacity == 0)
+                return 1;
+            return static_cast<consts::t_stat>(_size) / static_cast<consts::t_stat>(_capacity);
+        }
+
+        bool goodLoadFactor() const noexcept
+        {
+            if (this->_size == 0)
+                return this->_capacity;
+
+            consts::t_stat loadFact = this->loadFactor();
+            return loadFact <= this->_loadFactorMax && (loadFact >= this->shrinkLoadFactor() || this->_capacity <= this->_reservedCapacity);
+        }
+
+        consts::LoadFactorStatus loadFactorStatus() const noexcept
+        {
+            if (this->_size == 0)
+                if (this->_capacity == 0)
+                    return consts::LoadFactorStatus::ZERO_CAPACITY_AND_ZERO_SIZE;
+                else
+                    return consts::LoadFactorStatus::NOT_ZERO_CAPACITY_AND_ZERO_SIZE;
+
+            else if (this->loadFactor() > this->_loadFactorMax)
+                return consts::LoadFactorStatus::GREATER_MAX;
+            else if (this->loadFactor() < this->shrinkLoadFactor() && this->_capacity > this->_reservedCapacity)
+                return consts::LoadFactorStatus::LESS_MIN;
+
+            return consts::LoadFactorStatus::ALL_GOOD;
+        }
+
+        // The counters; the tables fill in the state fields they have. All zero for a table without counters.
+        Statistics statistics() const
+        {
+            if (!this->counting())
+                return Statistics();
+
+            Statistics result = this->_counters->statistics;
+
+            for (int operation = 0; operation < Statistics::OPERATIONS; ++operation)
+            {
+                for (consts::t_uIndex length = 0; length < consts::STATISTICS_PROBE_LENGTHS; ++length)
+                    result.probes[operation][length] = this->_counters->probes.counts[operation][length].load(std::memory_order_relaxed);
+            }
+
+            return result;
+        }
+
+    protected:
+        consts::t_uIndex _size;
+        consts::t_uIndex _capacity;
+        consts::t_stat _loadFactorMax;
+        consts::t_stat _loadFactorMin;
+
+        // Capacity set by reserve/rehash: a table this large is not shrunk for a low load factor.
+        consts::t_uIndex _reservedCapacity;
+
+        policy::Growth _growth;
+
+        // Probes are counted by const lookups, which may run in parallel: relaxed atomics. A copy takes the values.
+        struct ProbeCounters
+        {
+            std::atomic<unsigned long long> counts[Statistics::OPERATIONS][consts::STATISTICS_PROBE_LENGTHS] = {};
+
+            ProbeCounters() = default;
+
+            ProbeCounters(const ProbeCounters &other) noexcept
+            {
+                *this = other;
+            }
+
+            ProbeCounters &operator=(const ProbeCounters &other) noexcept
+            {
+                for (int operation = 0; operation < Statistics::OPERATIONS; ++operation)
+                {
+                    for (consts::t_uIndex length = 0; length < consts::STATISTICS_PROBE_LENGTHS; ++length)
+                        this->counts[operation][length].store(other.counts[operation][length].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+
+                return *this;
+            }
+        };
+
+        // The other counters change with the table, under the exclusive lock of a concurrent one.
+        struct Counters
+        {
+            Statistics statistics;
+            ProbeCounters probes;
+        };
+
+        /*
+         * Owns the counters of a table, allocated only by a constructor compiled with HASHTABLE_STATISTICS
+         * defined. Nothing else depends on the macro: the layout, the virtual functions and the code of a
+         * table are the same in translation units built with and without it, and a table made without
+         * counters counts nothing wherever it is used. A copy or a move copies the counters.
+         */
+        class CountersPointer
+        {
+        private:
+            Counters *counters;
+
+        public:
+            CountersPointer() noexcept(false) : counters(nullptr)
+            {
+#ifdef HASHTABLE_STATISTICS
+                this->counters = new Counters();
+#endif
+            }
+
+            CountersPointer(const CountersPointer &other) noexcept(false) : counters(other.counters ? new Counters(*other.counters) : nullptr) {}
+
+            CountersPointer &operator=(const CountersPointer &other) noexcept
+            {
+                if (this->counters && other.counters)
+                    *this->counters = *other.counters;
+
+                return *this;
+            }
+
+            ~CountersPointer()
+            {
+                delete this->counters;
+            }
+
+            Counters *operator->() const noexcept
+            {
+                return this->counters;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return this->counters;
+            }
+        };
+
+        mutable CountersPointer _counters;
+
+        // Whether the table has counters, see CountersPointer.
+        bool counting() const noexcept
+        {
+            return static_cast<bool>(this->_counters);
+        }
+
+        // Times a rebuild for a new capacity till the end of its scope. Does nothing for a table without counters.
+        class ReCapacityTimer
+        {
+        private:
+            Statistics *statistics;
+            std::chrono::steady_clock::time_point start;
+
+        public:
+            explicit ReCapacityTimer(const HashTableBase &table) noexcept : statistics(table.counting() ? &table._counters->statistics : nullptr)
+            {
+                if (this->statistics)
+                    this->start = std::chrono::steady_clock::now();
+            }
+
+            ~ReCapacityTimer()
+            {
+                if (!this->statistics)
+                    return;
+
+                ++this->statistics->reCapacities;
+                this->statistics->reCapacityNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count();
+            }
+        };
+
+        // Adds an operation that looked at "length" slots or elements to the histogram. Does nothing for a table without counters.
+        void countProbes(const Statistics::Operation &operation, const consts::t_uIndex &length) const noexcept
+        {
+            if (this->counting())
+                this->_counters->probes.counts[operation][std::min(length, consts::STATISTICS_PROBE_LENGTHS - 1)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        HashTableBase(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : _size(0), _capacity(capacity), _reservedCapacity(0), _growth(policy::Growth::geometric())
+        {
+            if (loadFactorMax >= 1 || loadFactorMax <= 0)
+                throw std::out_of_range("LoadFactorMax must be less than or equal to 1, greater than or equal to 0");
+
+            if (loadFactorMin >= 1 || loadFactorMin <= 0)
+                throw std::out_of_range("LoadFactorMin must be less than or equal to 1, greater than or equal to 0");
+
+            else if (loadFactorMin == loadFactorMax)
+                throw std::invalid_argument("Factors cannot be equal");
+
+            if (loadFactorMin > loadFactorMax)
+            {
+                this->_loadFactorMax = loadFactorMin;
+                this->_loadFactorMin = loadFactorMax;
+            }
+            else
+            {
+                this->_loadFactorMin = loadFactorMin;
+                this->_loadFactorMax = loadFactorMax;
+            }
+        }
+
+        // Smallest capacity that holds "count" elements within the maximum load factor, as loadFactor() computes it.
+        consts::t_uIndex capacityFor(const consts::t_uIndex &count) const noexcept
+        {
+            consts::t_uIndex result = static_cast<consts::t_uIndex>(std::ceil(count / static_cast<double>(this->_loadFactorMax)));
+
+            while (result && static_cast<consts::t_stat>(count) / static_cast<consts::t_stat>(result) > this->_loadFactorMax)
+                ++result;
+
+            return result;
+        }
+
+        // Load factor under which the table shrinks.
+        consts::t_stat shrinkLoadFactor() const noexcept
+        {
+            return this->_loadFactorMin * this->_growth.shrinkHysteresis;
+        }
+
+        // Capacity of an overloaded table before rounding: "factor" times larger, at least enough for
+        // the elements, and not so large that the table is under the shrink threshold.
+        consts::t_uIndex grownCapacity() const noexcept
+        {
+            double result = this->_capacity * static_cast<double>(this->_growth.factor);
+
+            if (this->_growth.shrinkHysteresis > 0)
+                result = std::min(result, this->_size / static_cast<double>(this->shrinkLoadFactor()));
+
+            return std::max(static_cast<consts::t_uIndex>(result), this->capacityFor(this->_size));
+        }
+
+        // Capacity of an underloaded table before rounding: halfway between the load factors, not less than the reserved one.
+        consts::t_uIndex shrunkCapacity() const noexcept
+        {
+            return std::max(static_cast<consts::t_uIndex>(this->_size / ((this->_loadFactorMax + this->_loadFactorMin) / 2)), this->_reservedCapacity);
+        }
+
+        // Whether the rounded capacity from shrunkCapacity() is smaller and still holds the elements within loadFactorMax.
+        bool shrinksTo(const consts::t_uIndex &newCapacity) const noexcept
+        {
+            return newCapacity < this->_capacity && this->capacityFor(this->_size) <= newCapacity;
+        }
+
+        ~HashTableBase() {}
+    };
+}
+
+#endif
\ No newline at end of file
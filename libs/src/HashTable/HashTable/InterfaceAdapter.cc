@@ -0,0 +1,148 @@
+#ifndef __HashTable_InterfaceAdapter_Class__
+#define __HashTable_InterfaceAdapter_Class__
+
+#include <string>
+
+#include "HashTableInterface.cc"
+
+namespace HashTable
+{
+    /**
+     * HashTableInterface over a table, for code that has to choose the table at run time:
+     *
+     *     HashTableInterface<int, int> *table = new InterfaceAdapter<LinearProbing<int, int>>();
+     *
+     * Every call costs one virtual dispatch, the table itself is reachable through get().
+     */
+    template <class Ttable>
+    class InterfaceAdapter : public HashTableInterface<typename Ttable::t_key, typename Ttable::t_data>
+    {
+    private:
+        using Tkey = typename Ttable::t_key;
+        using Tdata = typename Ttable::t_data;
+
+        Ttable table;
+
+    public:
+        explicit InterfaceAdapter(const Ttable &table = Ttable()) : table(table) {}
+
+        Ttable &get() noexcept
+        {
+            return table;
+        }
+
+        const Ttable &get() const noexcept
+        {
+            return table;
+        }
+
+        consts::t_uIndex size() const noexcept override
+        {
+            return table.size();
+        }
+
+        consts::t_uIndex capacity() const noexcept override
+        {
+            return table.capacity();
+        }
+
+        consts::t_stat getLoadFactorMin() const noexcept override
+        {
+            return table.getLoadFactorMin();
+        }
+
+        consts::t_stat getLoadFactorMax() const noexcept override
+        {
+            return table.getLoadFactorMax();
+        }
+
+        consts::t_stat setLoadFactorMin(consts::t_stat newLoadFactorMin) noexcept(false) override
+        {
+            return table.setLoadFactorMin(newLoadFactorMin);
+        }
+
+        consts::t_stat setLoadFactorMax(consts::t_stat newLoadFactorMax) noexcept(false) override
+        {
+            return table.setLoadFactorMax(newLoadFactorMax);
+        }
+
+        policy::Growth getGrowth() const noexcept override
+        {
+            return table.getGrowth();
+        }
+
+        policy::Growth setGrowth(const policy::Growth &newGrowth) noexcept(false) override
+        {
+            return table.setGrowth(newGrowth);
+        }
+
+        consts::t_stat loadFactor() const override
+        {
+            return table.loadFactor();
+        }
+
+        bool goodLoadFactor() const noexcept override
+        {
+            return table.goodLoadFactor();
+        }
+
+        consts::LoadFactorStatus loadFactorStatus() const noexcept override
+        {
+            return table.loadFactorStatus();
+        }
+
+        void clear() noexcept override
+        {
+            table.clear();
+        }
+
+        bool reCapacity() noexcept(false) override
+        {
+            return table.reCapacity();
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false) override
+        {
+            return table.insert(key, data);
+        }
+
+        bool erase(const Tkey &key) noexcept(false) override
+        {
+            return table.erase(key);
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false) override
+        {
+            return table.add(key, data);
+        }
+
+        bool remove(const Tkey &key) noexcept(false) override
+        {
+            return table.remove(key);
+        }
+
+        bool containsKey(const Tkey &key) noexcept override
+        {
+            return table.containsKey(key);
+        }
+
+        bool contains(const Tdata &data) const override
+        {
+            return table.contains(data);
+        }
+
+        Statistics statistics() const override
+        {
+            return table.statistics();
+        }
+
+        std::string toString() const override
+        {
+            return table.toString();
+        }
+
+        virtual ~InterfaceAdapter() {}
+    };
+}
+
+#endif
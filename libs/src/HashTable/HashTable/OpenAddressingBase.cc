@@ -2,279 +2,279 @@
 #define __HashTable_OpenAddressingBase_Interface__
 
 #include <string>
+#include <utility>
 
-#include "HashTableInterface.cc"
-#include "typeNode/OpenAddressing.cc"
+#include "HashTableBase.cc"
+#include "policy/Capacity.cc"
+#include "policy/KeyEqual.cc"
+#include "policy/Probe.cc"
+#include "typeNode/OpenAddressingFlat.cc"
+#include "typeNode/SlotIterator.cc"
 
 namespace HashTable
 {
-    template <class Tkey, class Tdata>
-    class OpenAddressingBase : public HashTableInterface<Tkey, Tdata>
+    /**
+     * Open addressing over the full hash of a key: the capacity policy maps the hash to the home slot.
+     * With cacheHash the hash is stored in every slot, a probe compares keys only when the hashes
+     * are equal and a rebuild takes the hashes from the slots instead of hashing the keys again.
+     * The lookups take a key of any type Tequal compares with Tkey, see policy/Transparent.cc.
+     */
+    template <class Tkey, class Tdata, class Tcapacity = policy::CapacityModulus<Tkey>, class Tequal = policy::KeyEqual<Tkey>, class Tprobe = policy::ProbeLinear, bool cacheHash = false>
+    class OpenAddressingBase : public HashTableBase<Tkey, Tdata>
     {
     public:
-        void clear() noexcept override
+        // Forward iterators over the elements, each is a Slot with key and data, see typeNode::SlotIterator.
+        using Iterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash>, false>;
+        using ConstIterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash>, true>;
+
+        void clear() noexcept
         {
-            if (table)
-            {
-                delete[] table;
+            table.clear();
 
-                table = nullptr;
-            }
+            // Without slots: the next add or insert makes them again.
+            this->_size = 0;
+            this->_capacity = 0;
+            this->tombstones = 0;
         }
 
-        std::string toString() const override;
+        std::string toString() const;
 
     protected:
-        HashTable::typeNode::OpenAddressing<Tkey, Tdata> *table;
+        HashTable::typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash> table;
+        Tcapacity capacityPolicy;
+        Tequal keyEqual;
+
+        // Erased slots that a probe still walks past, until an insert takes one back or a rebuild drops them.
+        consts::t_uIndex tombstones = 0;
 
-        OpenAddressingBase(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : HashTableInterface<Tkey, Tdata>(capacity, loadFactorMin, loadFactorMax), table(nullptr)
+        OpenAddressingBase(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : HashTableBase<Tkey, Tdata>(Tcapacity::round(capacity), loadFactorMin, loadFactorMax), table(Tcapacity::round(capacity)), capacityPolicy(Tcapacity::round(capacity)) {}
+
+        OpenAddressingBase(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax, const Tcapacity &capacityPolicy) : HashTableBase<Tkey, Tdata>(Tcapacity::round(capacity), loadFactorMin, loadFactorMax), table(Tcapacity::round(capacity)), capacityPolicy(capacityPolicy)
         {
-            if (this->capacity())
-            {
-                table = new typeNode::OpenAddressing<Tkey, Tdata>[this->capacity()];
-            }
+            this->capacityPolicy.resize(this->capacity());
         }
 
-        bool insert(const consts::t_uIndex &hashIndex, const Tkey &key, const Tdata &data) noexcept
+        template <class Tk>
+        bool equalKey(const consts::t_uIndex &index, const consts::t_uHash &hash, const Tk &key) const
         {
-            if(hashIndex >= this->capacity()) return false;
-            
-            bool searchNotOccuped = true, notSearchFirstFreeKey = true;
-            consts::t_uIndex safeIteratorIndex;
-            consts::t_uIndex iteratorIndex = hashIndex;
+            return table.isOccupied(index) && table.sameHash(index, hash) && this->keyEqual(table.getKey(index), key);
+        }
 
-            do
-            {
-                if (searchNotOccuped && table[iteratorIndex].nullKey() && table[iteratorIndex].getOccuped())
-                {
-                    searchNotOccuped = false;
-                }
+        // Full hash of the key of an occupied slot: the stored one, or the key is hashed again.
+        consts::t_uHash slotHash(const consts::t_uIndex &index) const
+        {
+            if constexpr (cacheHash)
+                return table.getHash(index);
+            else
+                return this->capacityPolicy.hash(table.getKey(index));
+        }
 
-                if (searchNotOccuped && table[iteratorIndex].nullKey())
-                {
-                    if (this->size() == this->capacity() || !table)
-                        return false;
+        // The elements and the tombstones together are over the maximum load factor: a miss walks the tombstones
+        // as far as the elements, so once erases have left enough of them the table needs a rebuild.
+        bool overloaded() const noexcept
+        {
+            return this->size() + this->tombstones > this->capacity() * this->getLoadFactorMax();
+        }
 
-                    table[iteratorIndex].set(key, data);
-                    table[iteratorIndex].setOccuped(true);
-                    ++this->_size;
+        // Prefetches the home slot of a key with the hash, see searchBatch of the tables.
+        void prefetch(const consts::t_uHash &hash) const noexcept
+        {
+            if (table.allocated())
+                table.prefetch(this->capacityPolicy.indexOf(hash));
+        }
 
-                    return true;
-                }
+        // Index of the slot with the key, or capacity() if there is no such key. The probe counts for "operation", see Statistics.
+        template <class Tk>
+        consts::t_uIndex find(const consts::t_uHash &hash, const Tk &key, const Statistics::Operation &operation = Statistics::SEARCH) const noexcept
+        {
+            if (!table.allocated())
+                return this->capacity();
+
+            consts::t_uIndex iteratorIndex = this->capacityPolicy.indexOf(hash);
 
-                if (table[iteratorIndex].equalKey(key))
+            for (consts::t_uIndex step = 1; step <= this->capacity(); ++step)
+            {
+                if (table.isEmpty(iteratorIndex))
                 {
-                    table[iteratorIndex].setData(data);
-                    return true;
+                    this->countProbes(operation, step);
+                    return this->capacity();
                 }
 
-                if (notSearchFirstFreeKey && table[iteratorIndex].nullKey())
+                if (this->equalKey(iteratorIndex, hash, key))
                 {
-                    safeIteratorIndex = iteratorIndex;
-                    notSearchFirstFreeKey = false;
+                    this->countProbes(operation, step);
+                    return iteratorIndex;
                 }
 
-                iteratorIndex = (iteratorIndex + 1) % this->capacity();
-
-            } while (iteratorIndex != hashIndex);
-
-            if (this->size() == this->capacity() || !table)
-                return false;
-
-            table[safeIteratorIndex].set(key, data);
-            ++this->_size;
+                iteratorIndex = Tprobe::next(this->capacityPolicy, iteratorIndex, step);
+            }
 
-            return true;
+            this->countProbes(operation, this->capacity());
+            return this->capacity();
         }
 
-        bool erase(const consts::t_uIndex &hashIndex, const Tkey &key) noexcept
+        // Index of the slot with the key (found = true), otherwise index of the first free slot
+        // of the probe sequence (found = false), or capacity() if the table is full.
+        template <class Tk>
+        consts::t_uIndex findForInsert(const consts::t_uHash &hash, const Tk &key, bool &found) const noexcept
         {
-            if(hashIndex >= this->capacity()) return false;
+            found = false;
+
+            if (!table.allocated())
+                return this->capacity();
 
-            consts::t_uIndex iteratorIndex = hashIndex;
+            consts::t_uIndex safeIteratorIndex = this->capacity();
+            consts::t_uIndex iteratorIndex = this->capacityPolicy.indexOf(hash);
 
-            do
+            for (consts::t_uIndex step = 1; step <= this->capacity(); ++step)
             {
-                if (!table[iteratorIndex].getOccuped())
-                    return false;
+                if (table.isEmpty(iteratorIndex))
+                {
+                    this->countProbes(Statistics::INSERT, step);
+                    return safeIteratorIndex == this->capacity() ? iteratorIndex : safeIteratorIndex;
+                }
 
-                if (table[iteratorIndex].equalKey(key))
+                if (this->equalKey(iteratorIndex, hash, key))
                 {
-                    table[iteratorIndex].clear();
-                    --this->_size;
-                    return true;
+                    this->countProbes(Statistics::INSERT, step);
+                    found = true;
+                    return iteratorIndex;
                 }
 
-                iteratorIndex = (iteratorIndex + 1) % this->capacity();
+                if (safeIteratorIndex == this->capacity() && table.isTombstone(iteratorIndex))
+                    safeIteratorIndex = iteratorIndex;
 
-            } while (iteratorIndex != hashIndex);
+                iteratorIndex = Tprobe::next(this->capacityPolicy, iteratorIndex, step);
+            }
 
-            return false;
+            this->countProbes(Statistics::INSERT, this->capacity());
+            return safeIteratorIndex;
         }
 
-        bool add(const consts::t_uIndex &hashIndex, const Tkey &key, const Tdata &data) noexcept
+        // The key must be absent and the table must have a free slot: a rebuild places distinct keys
+        // into a new table without comparing them.
+        template <class Tk, class Td>
+        void place(const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
         {
-            if(hashIndex >= this->capacity()) return false;
-
-            consts::t_uIndex iteratorIndex = hashIndex;
-            bool searchNotOccuped = true, notSearchFirstFreeKey = true;
-            consts::t_uIndex safeIteratorIndex;
-
-            do
-            {
-                if (searchNotOccuped && table[iteratorIndex].nullKey() && table[iteratorIndex].getOccuped())
-                {
-                    searchNotOccuped = false;
-                }
+            consts::t_uIndex index = this->capacityPolicy.indexOf(hash);
 
-                if (searchNotOccuped && table[iteratorIndex].nullKey())
-                {
-
-                    table[iteratorIndex].set(key, data);
-                    table[iteratorIndex].setOccuped(true);
-                    ++this->_size;
+            for (consts::t_uIndex step = 1; table.isOccupied(index); ++step)
+                index = Tprobe::next(this->capacityPolicy, index, step);
 
-                    if (!this->goodLoadFactor())
-                        this->reCapacity();
+            if (table.isTombstone(index))
+                --this->tombstones;
 
-                    return true;
-                }
+            table.construct(index, typeNode::consts::CONTROL_OCCUPIED, hash, std::forward<Tk>(key), std::forward<Td>(data));
+            ++this->_size;
+        }
 
-                if (table[iteratorIndex].equalKey(key))
-                {
-                    return false;
-                }
+        template <class Tk, class Td>
+        bool insert(const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
+        {
+            bool found;
+            consts::t_uIndex index = this->findForInsert(hash, key, found);
 
-                if (notSearchFirstFreeKey && table[iteratorIndex].nullKey())
-                {
-                    safeIteratorIndex = iteratorIndex;
-                    notSearchFirstFreeKey = false;
-                }
+            if (index == this->capacity())
+                return false;
 
-                iteratorIndex = (iteratorIndex + 1) % this->capacity();
+            if (found)
+            {
+                table.setData(index, std::forward<Td>(data));
+                return true;
+            }
 
-            } while (iteratorIndex != hashIndex);
+            if (table.isTombstone(index))
+                --this->tombstones;
 
-            table[safeIteratorIndex].set(key, data);
+            table.construct(index, typeNode::consts::CONTROL_OCCUPIED, hash, std::forward<Tk>(key), std::forward<Td>(data));
             ++this->_size;
 
-            if (!this->goodLoadFactor())
-                this->reCapacity();
-
             return true;
         }
 
-        bool remove(const consts::t_uIndex &hashIndex, const Tkey &key) noexcept
+        // Slot of the key and whether it was added now. The data is constructed from the arguments
+        // only if the key is absent, otherwise the arguments are not touched. {capacity(), false} if the table is full.
+        template <class Tk, class... Targs>
+        std::pair<consts::t_uIndex, bool> tryEmplace(const consts::t_uHash &hash, Tk &&key, Targs &&...args) noexcept(false)
         {
-            if(!this->table || hashIndex >= this->capacity()) return false;
+            bool found;
+            consts::t_uIndex index = this->findForInsert(hash, key, found);
 
-            consts::t_uIndex iteratorIndex = hashIndex;
+            if (found || index == this->capacity())
+                return {index, false};
 
-            do
-            {
-                if (!table[iteratorIndex].getOccuped())
-                    return false;
-
-                if (table[iteratorIndex].equalKey(key))
-                {
-                    table[iteratorIndex].clear();
-                    --this->_size;
-                    if (!this->goodLoadFactor())
-                        this->reCapacity();
-                    return true;
-                }
-
-                iteratorIndex = (iteratorIndex + 1) % this->capacity();
+            if (table.isTombstone(index))
+                --this->tombstones;
 
-            } while (iteratorIndex != hashIndex);
+            table.construct(index, typeNode::consts::CONTROL_OCCUPIED, hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+            ++this->_size;
 
-            return false;
+            return {index, true};
         }
 
-        Tdata *search(const consts::t_uIndex &hashIndex, const Tkey &key) noexcept
+        template <class Tk>
+        bool erase(const consts::t_uHash &hash, const Tk &key) noexcept
         {
-            if(!this->table || hashIndex >= this->capacity()) return nullptr;
-            
-            consts::t_uIndex iteratorIndex = hashIndex;
+            consts::t_uIndex index = this->find(hash, key, Statistics::ERASE);
 
-            do
-            {
-                if (!table[iteratorIndex].getOccuped())
-                    return nullptr;
-
-                if (table[iteratorIndex].equalKey(key))
-                {
-                    return table[iteratorIndex].getData();
-                }
-
-                iteratorIndex = (iteratorIndex + 1) % this->capacity();
+            if (index == this->capacity())
+                return false;
 
-            } while (iteratorIndex != hashIndex);
+            table.erase(index);
+            --this->_size;
+            ++this->tombstones;
 
-            return nullptr;
+            return true;
         }
 
-        virtual ~OpenAddressingBase()
+        template <class Tk, class Td>
+        bool add(const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
         {
-            this->clear();
+            return this->tryEmplace(hash, std::forward<Tk>(key), std::forward<Td>(data)).second;
         }
-    };
-
-
-    template <>
-    std::string OpenAddressingBase<std::string, std::string>::toString() const
-    {
-        std::string result;
-
-        result += "OpenAddressingTable: {\n";
 
-        if (table)
+        template <class Tk>
+        bool remove(const consts::t_uHash &hash, const Tk &key) noexcept(false)
         {
-            for (consts::t_uIndex i = 0, j = 0; i < this->capacity(); ++i)
-            {
-                auto key = table[i].getKey();
+            return this->erase(hash, key);
+        }
 
-                if (key)
-                {
-                    result += "\t" + *key;
+        template <class Tk>
+        Tdata *search(const consts::t_uHash &hash, const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(hash, key);
 
-                    result += " : ";
+            if (index == this->capacity())
+                return nullptr;
 
-                    result += *table[i].getData();
+            return &table.getData(index);
+        }
 
-                    if (j < this->size() - 1)
-                    {
-                        result += ",\n";
-                        ++j;
-                    }
-                }
-            }
+        ~OpenAddressingBase()
+        {
+            this->clear();
         }
+    };
 
-        result += "\n};";
-        return result;
-    }
 
-    template <class Tkey, class Tdata>
-    std::string OpenAddressingBase<Tkey, Tdata>::toString() const
+    template <class Tkey, class Tdata, class Tcapacity, class Tequal, class Tprobe, bool cacheHash>
+    std::string OpenAddressingBase<Tkey, Tdata, Tcapacity, Tequal, Tprobe, cacheHash>::toString() const
     {
         std::string result;
 
         result += "OpenAddressingTable: {\n";
 
-        if (table)
+        if (table.allocated())
         {
             for (consts::t_uIndex i = 0, j = 0; i < this->capacity(); ++i)
             {
-                auto key = table[i].getKey();
-
-                if (key)
+                if (table.isOccupied(i))
                 {
-                    result += "\t" + std::to_string(*key);
+                    result += "\t" + tools::toString(table.getKey(i));
 
                     result += " : ";
 
-                    result += std::to_string(*table[i].getData());
+                    result += tools::toString(table.getData(i));
 
                     if (j < this->size() - 1)
                     {
@@ -0,0 +1,307 @@
+#ifndef __HashTable_Serialization_Class__
+#define __HashTable_Serialization_Class__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "HashTableBase.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        // "HTSTRM" and the byte order mark 0x0102: a stream of a machine with another byte order is refused.
+        const std::uint64_t SERIALIZATION_MAGIC = 0x48'54'53'54'52'4D'01'02ull;
+        const std::uint32_t SERIALIZATION_VERSION = 2;
+
+        // save writes the output in pieces of this size, memory stays flat for any table.
+        const std::size_t SERIALIZATION_CHUNK = 1 << 16;
+
+        // A stream cannot show that it holds the count of its header: load reserves no more elements than this for it.
+        const std::uint64_t SERIALIZATION_STREAM_RESERVE = 1 << 24;
+    }
+
+    /**
+     * Streaming binary form of a table:
+     *
+     *     header:  magic u64, version u32, key size u32, data size u32, kinds u32, count u64
+     *     count x: key, data
+     *
+     * A trivially copyable type is written as its bytes and its size is in the header; a std::string
+     * is its length u64 and its bytes, size 0 in the header. The kinds are tools::typeKind of the key
+     * and of the data << 16: with the sizes they tell an int from a float. Numbers are in the byte
+     * order of the machine, the magic tells another one. Other key and data types are refused at
+     * compile time.
+     *
+     * Errors throw std::runtime_error: a stream that fails, a header of other types or version, a
+     * truncated or corrupt body. A string length is checked against the rest of a buffer; from a
+     * stream the string grows a chunk at a time as its bytes arrive, so a corrupt length fails at the
+     * end of the input instead of allocating it. A load that fails before the first element (the header, or a buffer
+     * too short for the count) leaves the table as it was, a later failure leaves it empty.
+     */
+    namespace serialization
+    {
+        // Collects the bytes into chunks of SERIALIZATION_CHUNK: one write to the stream or append to the buffer per chunk.
+        class Writer
+        {
+        private:
+            std::ostream *out = nullptr;
+            std::string *buffer = nullptr;
+            std::unique_ptr<char[]> chunk;
+            std::size_t used = 0;
+
+            void emit(const char *data, const std::size_t &size) noexcept(false)
+            {
+                if (buffer)
+                {
+                    buffer->append(data, size);
+                    return;
+                }
+
+                if (static_cast<std::size_t>(out->rdbuf()->sputn(data, size)) != size)
+                {
+                    out->setstate(std::ios_base::badbit);
+                    throw std::runtime_error("serialization: cannot write the stream");
+                }
+            }
+
+        public:
+            explicit Writer(std::ostream &out) : out(&out), chunk(new char[consts::SERIALIZATION_CHUNK]) {}
+
+            explicit Writer(std::string &buffer) : buffer(&buffer), chunk(new char[consts::SERIALIZATION_CHUNK]) {}
+
+            void write(const void *data, const std::size_t &size) noexcept(false)
+            {
+                if (used + size > consts::SERIALIZATION_CHUNK)
+                    this->flush();
+
+                // A long string goes out past the chunk.
+                if (size > consts::SERIALIZATION_CHUNK)
+                {
+                    this->emit(static_cast<const char *>(data), size);
+                    return;
+                }
+
+                std::memcpy(chunk.get() + used, data, size);
+                used += size;
+            }
+
+            template <class T>
+            void write(const T &value) noexcept(false)
+            {
+                this->write(&value, sizeof(T));
+            }
+
+            void flush() noexcept(false)
+            {
+                if (used)
+                    this->emit(chunk.get(), used);
+
+                used = 0;
+            }
+        };
+
+        // Reads exactly the bytes of the table: a stream is left right after them.
+        class Reader
+        {
+        private:
+            std::istream *in = nullptr;
+            const char *position = nullptr;
+            const char *end = nullptr;
+
+            [[noreturn]] static void truncated() noexcept(false)
+            {
+                throw std::runtime_error("serialization: the input ends before the table");
+            }
+
+        public:
+            explicit Reader(std::istream &in) : in(&in) {}
+
+            Reader(const char *data, const std::size_t &size) : position(data), end(data + size) {}
+
+            // Fails early when a buffer has fewer than "size" bytes left, before room for them is made.
+            // A stream does not know its length, its reads check the bytes as they come.
+            void require(const std::uint64_t &size) const noexcept(false)
+            {
+                if (!in && size > static_cast<std::uint64_t>(end - position))
+                    truncated();
+            }
+
+            // Bytes of a read of "size" to make room for at once: all of them from a buffer, after require,
+            // at most a chunk from a stream.
+            std::uint64_t piece(const std::uint64_t &size) const noexcept
+            {
+                return in ? std::min<std::uint64_t>(size, consts::SERIALIZATION_CHUNK) : size;
+            }
+
+            bool stream() const noexcept
+            {
+                return in;
+            }
+
+            void read(void *data, const std::size_t &size) noexcept(false)
+            {
+                if (in)
+                {
+                    if (static_cast<std::size_t>(in->rdbuf()->sgetn(static_cast<char *>(data), size)) != size)
+                    {
+                        in->setstate(std::ios_base::failbit | std::ios_base::eofbit);
+                        truncated();
+                    }
+                    return;
+                }
+
+                this->require(size);
+                std::memcpy(data, position, size);
+                position += size;
+            }
+
+            template <class T>
+            T read() noexcept(false)
+            {
+                T value;
+
+                this->read(&value, sizeof(T));
+                return value;
+            }
+        };
+
+        template <class T>
+        struct Codec
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "serialization keeps trivially copyable types and std::string only");
+
+            static constexpr std::uint32_t SIZE = sizeof(T);
+
+            static void write(Writer &writer, const T &value) noexcept(false)
+            {
+                writer.write(value);
+            }
+
+            static void read(Reader &reader, T &value) noexcept(false)
+            {
+                reader.read(&value, sizeof(T));
+            }
+        };
+
+        template <>
+        struct Codec<std::string>
+        {
+            static constexpr std::uint32_t SIZE = 0;
+
+            static void write(Writer &writer, const std::string &value) noexcept(false)
+            {
+                writer.write(static_cast<std::uint64_t>(value.size()));
+                writer.write(value.data(), value.size());
+            }
+
+            static void read(Reader &reader, std::string &value) noexcept(false)
+            {
+                std::uint64_t size = reader.read<std::uint64_t>();
+
+                reader.require(size);
+
+                if (size > value.max_size())
+                    throw std::runtime_error("serialization: a string is too long, the input is corrupt");
+
+                value.clear();
+
+                for (std::uint64_t done = 0; done < size;)
+                {
+                    std::uint64_t piece = reader.piece(size - done);
+
+                    value.resize(static_cast<std::size_t>(done + piece));
+                    reader.read(&value[static_cast<std::size_t>(done)], static_cast<std::size_t>(piece));
+                    done += piece;
+                }
+            }
+        };
+
+        // The kinds field of the header.
+        template <class Tkey, class Tdata>
+        constexpr std::uint32_t kinds() noexcept
+        {
+            return tools::typeKind<Tkey>() | tools::typeKind<Tdata>() << 16;
+        }
+
+        template <class Ttable>
+        void save(const Ttable &table, Writer &writer) noexcept(false)
+        {
+            using Tkey = typename Ttable::t_key;
+            using Tdata = typename Ttable::t_data;
+
+            writer.write(consts::SERIALIZATION_MAGIC);
+            writer.write(consts::SERIALIZATION_VERSION);
+            writer.write(Codec<Tkey>::SIZE);
+            writer.write(Codec<Tdata>::SIZE);
+            writer.write(kinds<Tkey, Tdata>());
+            writer.write(static_cast<std::uint64_t>(table.size()));
+
+            for (const auto &item : table)
+            {
+                Codec<Tkey>::write(writer, item.key);
+                Codec<Tdata>::write(writer, item.data);
+            }
+
+            writer.flush();
+        }
+
+        // The table is sized for the count of the header at once, no reCapacity happens on the way;
+        // from a stream for SERIALIZATION_STREAM_RESERVE elements at most, it grows past them as they arrive.
+        template <class Ttable>
+        void load(Ttable &table, Reader &reader) noexcept(false)
+        {
+            using Tkey = typename Ttable::t_key;
+            using Tdata = typename Ttable::t_data;
+
+            bool valid = reader.read<std::uint64_t>() == consts::SERIALIZATION_MAGIC;
+
+            valid = valid && reader.read<std::uint32_t>() == consts::SERIALIZATION_VERSION;
+            valid = valid && reader.read<std::uint32_t>() == Codec<Tkey>::SIZE;
+            valid = valid && reader.read<std::uint32_t>() == Codec<Tdata>::SIZE;
+            valid = valid && reader.read<std::uint32_t>() == kinds<Tkey, Tdata>();
+
+            std::uint64_t count = valid ? reader.read<std::uint64_t>() : 0;
+
+            if (!valid || count > static_cast<consts::t_uIndex>(-1))
+                throw std::runtime_error("serialization: not a table of these types");
+
+            // Every element takes at least its fixed sizes or the length of a string.
+            reader.require(count * ((Codec<Tkey>::SIZE ? Codec<Tkey>::SIZE : sizeof(std::uint64_t)) + (Codec<Tdata>::SIZE ? Codec<Tdata>::SIZE : sizeof(std::uint64_t))));
+
+            table.clear();
+
+            try
+            {
+                table.reserve(static_cast<consts::t_uIndex>(reader.stream() ? std::min(count, consts::SERIALIZATION_STREAM_RESERVE) : count));
+
+                for (std::uint64_t i = 0; i < count; ++i)
+                {
+                    Tkey key;
+                    Tdata data;
+
+                    Codec<Tkey>::read(reader, key);
+                    Codec<Tdata>::read(reader, data);
+
+                    if (!table.add(std::move(key), std::move(data)))
+                        throw std::runtime_error("serialization: a key repeats, the input is corrupt");
+                }
+            }
+            catch (...)
+            {
+                table.clear();
+                throw;
+            }
+        }
+    }
+}
+
+#endif
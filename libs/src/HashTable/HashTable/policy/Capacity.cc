@@ -0,0 +1,262 @@
+#ifndef __HashTable_policy_Capacity_Class__
+#define __HashTable_policy_Capacity_Class__
+
+#include <stdexcept>
+
+#include "../../HashFunctions/FunctionModulus.cc"
+#include "../../HashFunctions/FunctionFibonacci.cc"
+
+namespace HashTable
+{
+    /**
+     * Capacity policies: which capacities a table may have, how a key is mapped to its home slot
+     * and how a probe sequence steps to the next slot. A policy owns the hash function, a seeded
+     * hash function is passed to the policy constructor and the policy is passed to the table.
+     *
+     * static t_uIndex round(capacity) - the nearest allowed capacity not less than the given one;
+     * resize(capacity)                - the table got a new (rounded) capacity;
+     * t_uHash hash(key)               - full hash of the key, it does not depend on the capacity; a key
+     *                                   of another type is passed on to a transparent hash function;
+     * t_uIndex indexOf(hash)          - home slot of a key with the full hash;
+     * t_uIndex index(key)             - home slot of the key, indexOf(hash(key));
+     * t_uIndex next(index)            - next slot of the probe sequence;
+     * t_uIndex advance(index, n)      - slot n positions after the index, n <= capacity;
+     * t_hashFunction                  - type of the hash function.
+     */
+    namespace policy
+    {
+        namespace consts
+        {
+            using t_uIndex = unsigned int;
+            using t_uHash = HashFunctions::consts::t_uHash;
+        }
+
+        // Odd capacities, index is the hash reduced by the division: the original behaviour of the tables.
+        // An odd divisor keeps keys that differ only in the high bits apart, a geometric growth from
+        // an odd capacity would otherwise reach multiples of large powers of two.
+        template <class Tkey, class Thash = HashFunctions::FunctionModulus<Tkey>>
+        class CapacityModulus
+        {
+        private:
+            Thash hashFunction;
+            consts::t_uIndex _capacity;
+
+        public:
+            using t_hashFunction = Thash;
+
+            explicit CapacityModulus(const consts::t_uIndex &capacity) : hashFunction(capacity), _capacity(capacity) {}
+
+            CapacityModulus(const consts::t_uIndex &capacity, const Thash &hashFunction) : hashFunction(hashFunction), _capacity(capacity)
+            {
+                this->hashFunction.resize(capacity);
+            }
+
+            static consts::t_uIndex round(const consts::t_uIndex &capacity) noexcept
+            {
+                return capacity ? capacity | 1 : 0;
+            }
+
+            void resize(const consts::t_uIndex &capacity) noexcept
+            {
+                this->hashFunction.resize(capacity);
+                this->_capacity = capacity;
+            }
+
+            consts::t_uHash hash(const Tkey &key) const
+            {
+                return this->hashFunction.unreduced(key);
+            }
+
+            template <class Tother>
+            consts::t_uHash hash(const Tother &key) const
+            {
+                return this->hashFunction.unreduced(key);
+            }
+
+            consts::t_uIndex indexOf(const consts::t_uHash &hash) const noexcept
+            {
+                return static_cast<consts::t_uIndex>(hash % this->_capacity);
+            }
+
+            consts::t_uIndex index(const Tkey &key) const
+            {
+                return this->hashFunction.hash(key);
+            }
+
+            consts::t_uIndex next(const consts::t_uIndex &index) const noexcept
+            {
+                return index + 1 == this->_capacity ? 0 : index + 1;
+            }
+
+            consts::t_uIndex advance(const consts::t_uIndex &index, const consts::t_uIndex &distance) const noexcept
+            {
+                consts::t_uIndex result = index + distance;
+                return result >= this->_capacity ? result - this->_capacity : result;
+            }
+        };
+
+        // Power of two capacities: index is taken from the high bits of a full-width
+        // multiplicative (Fibonacci) hash, probes wrap around with a mask.
+        template <class Tkey, class Thash = HashFunctions::FunctionFibonacci<Tkey>>
+        class CapacityPowerOfTwo
+        {
+        private:
+            Thash hashFunction;
+            consts::t_uIndex shift;
+            consts::t_uIndex mask;
+
+        public:
+            using t_hashFunction = Thash;
+
+            static constexpr consts::t_uIndex MAX_CAPACITY = ~(~consts::t_uIndex(0) >> 1);
+
+            explicit CapacityPowerOfTwo(const consts::t_uIndex &capacity, const Thash &hashFunction = Thash()) : hashFunction(hashFunction)
+            {
+                this->resize(capacity);
+            }
+
+            // Above the largest power of two of t_uIndex there is no capacity to round up to.
+            static consts::t_uIndex round(const consts::t_uIndex &capacity) noexcept(false)
+            {
+                if (capacity <= 1)
+                    return capacity;
+
+                if (capacity > MAX_CAPACITY)
+                    throw std::length_error("Capacity must be less than or equal to the largest power of two of t_uIndex");
+
+                return 1u << (32 - __builtin_clz(capacity - 1));
+            }
+
+            void resize(const consts::t_uIndex &capacity) noexcept
+            {
+                consts::t_uIndex bits = capacity > 1 ? 31 - __builtin_clz(capacity) : 0;
+
+                // For a single slot the shift only has to keep the index inside the mask.
+                this->shift = bits ? 64 - bits : 63;
+                this->mask = capacity ? capacity - 1 : 0;
+            }
+
+            consts::t_uHash hash(const Tkey &key) const
+            {
+                return this->hashFunction.hash(key);
+            }
+
+            template <class Tother>
+            consts::t_uHash hash(const Tother &key) const
+            {
+                return this->hashFunction.hash(key);
+            }
+
+            consts::t_uIndex indexOf(const consts::t_uHash &hash) const noexcept
+            {
+                return static_cast<consts::t_uIndex>(hash >> this->shift) & this->mask;
+            }
+
+            consts::t_uIndex index(const Tkey &key) const
+            {
+                return this->indexOf(this->hashFunction.hash(key));
+            }
+
+            consts::t_uIndex next(const consts::t_uIndex &index) const noexcept
+            {
+                return (index + 1) & this->mask;
+            }
+
+            consts::t_uIndex advance(const consts::t_uIndex &index, const consts::t_uIndex &distance) const noexcept
+            {
+                return (index + distance) & this->mask;
+            }
+        };
+
+        // Prime capacities: index is the high half of a full-width hash reduced with a precomputed
+        // reciprocal (Lemire's fastmod), two multiplications instead of a division.
+        template <class Tkey, class Thash = HashFunctions::FunctionFibonacci<Tkey>>
+        class CapacityFastModulus
+        {
+        private:
+            Thash hashFunction;
+            consts::t_uHash reciprocal;
+            consts::t_uIndex _capacity;
+
+            static bool isPrime(const consts::t_uIndex &number) noexcept
+            {
+                if (number < 4)
+                    return number > 1;
+
+                if (number % 2 == 0)
+                    return false;
+
+                for (consts::t_uIndex divisor = 3; divisor <= number / divisor; divisor += 2)
+                {
+                    if (number % divisor == 0)
+                        return false;
+                }
+
+                return true;
+            }
+
+        public:
+            using t_hashFunction = Thash;
+
+            explicit CapacityFastModulus(const consts::t_uIndex &capacity, const Thash &hashFunction = Thash()) : hashFunction(hashFunction)
+            {
+                this->resize(capacity);
+            }
+
+            static consts::t_uIndex round(const consts::t_uIndex &capacity) noexcept
+            {
+                if (capacity <= 2)
+                    return capacity;
+
+                consts::t_uIndex result = capacity | 1;
+
+                while (!isPrime(result))
+                    result += 2;
+
+                return result;
+            }
+
+            void resize(const consts::t_uIndex &capacity) noexcept
+            {
+                this->_capacity = capacity;
+                this->reciprocal = capacity ? ~consts::t_uHash(0) / capacity + 1 : 0;
+            }
+
+            consts::t_uHash hash(const Tkey &key) const
+            {
+                return this->hashFunction.hash(key);
+            }
+
+            template <class Tother>
+            consts::t_uHash hash(const Tother &key) const
+            {
+                return this->hashFunction.hash(key);
+            }
+
+            consts::t_uIndex indexOf(const consts::t_uHash &hash) const noexcept
+            {
+                consts::t_uHash lowBits = this->reciprocal * static_cast<consts::t_uIndex>(hash >> 32);
+
+                return static_cast<consts::t_uIndex>((static_cast<unsigned __int128>(lowBits) * this->_capacity) >> 64);
+            }
+
+            consts::t_uIndex index(const Tkey &key) const
+            {
+                return this->indexOf(this->hashFunction.hash(key));
+            }
+
+            consts::t_uIndex next(const consts::t_uIndex &index) const noexcept
+            {
+                return index + 1 == this->_capacity ? 0 : index + 1;
+            }
+
+            consts::t_uIndex advance(const consts::t_uIndex &index, const consts::t_uIndex &distance) const noexcept
+            {
+                consts::t_uIndex result = index + distance;
+                return result >= this->_capacity ? result - this->_capacity : result;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef __HashTable_policy_KeyEqual_Class__
+#define __HashTable_policy_KeyEqual_Class__
+
+namespace HashTable
+{
+    namespace policy
+    {
+        // Key equality predicate of a table: bool operator()(const Tkey &stored, const Tkey &key).
+        // Transparent: a key of any type comparable with Tkey by == is accepted, see policy/Transparent.cc.
+        template <class Tkey>
+        struct KeyEqual
+        {
+            using is_transparent = void;
+
+            bool operator()(const Tkey &stored, const Tkey &key) const
+            {
+                return stored == key;
+            }
+
+            template <class Tother>
+            bool operator()(const Tkey &stored, const Tother &key) const
+            {
+                return stored == key;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef __HashTable_policy_NodeAllocator_Class__
+#define __HashTable_policy_NodeAllocator_Class__
+
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace HashTable
+{
+    /**
+     * Node allocators of the chain method, one per table, Tnode is the node type of its chains:
+     * Tnode *create(args...)   - a node constructed from the arguments;
+     * void destroy(node)       - destroys a node of create and takes its memory back;
+     * void release()           - frees the memory of all the nodes at once, their destructors must have run
+     *                            or be trivial;
+     * static bool releasesAll  - whether release() frees the nodes, otherwise every node needs destroy().
+     */
+    namespace policy
+    {
+        namespace consts
+        {
+            using t_uIndex = unsigned int;
+
+            // Nodes of the first block of AllocatorPool, every next block is twice as large up to POOL_MAX_BLOCK.
+            const t_uIndex POOL_FIRST_BLOCK = 64;
+            const t_uIndex POOL_MAX_BLOCK = 1 << 16;
+        }
+
+        // Every node by new and delete.
+        template <class Tnode>
+        struct AllocatorNew
+        {
+            static constexpr bool releasesAll = false;
+
+            template <class... Targs>
+            Tnode *create(Targs &&...args) noexcept(false)
+            {
+                return new Tnode(std::forward<Targs>(args)...);
+            }
+
+            void destroy(Tnode *node) noexcept
+            {
+                delete node;
+            }
+
+            void release() noexcept {}
+        };
+
+        /**
+         * Slab allocator: nodes are cut from large blocks one after another, destroyed nodes go to a
+         * free list and are reused first. A build makes one allocation per block instead of one per
+         * node, neighbouring nodes share cache lines and there is no malloc header per node.
+         * release() frees everything in O(blocks); memory of destroyed nodes stays in the pool until then.
+         */
+        template <class Tnode>
+        class AllocatorPool
+        {
+        private:
+            union Cell
+            {
+                Cell *next;
+                alignas(Tnode) unsigned char node[sizeof(Tnode)];
+            };
+
+            std::vector<Cell *> blocks;
+            Cell *freeList = nullptr;
+
+            // Not used yet part of the last block.
+            Cell *free = nullptr;
+            Cell *end = nullptr;
+
+            // Nodes of the next block.
+            consts::t_uIndex blockSize = consts::POOL_FIRST_BLOCK;
+
+            Cell *cell() noexcept(false)
+            {
+                if (this->freeList)
+                {
+                    Cell *result = this->freeList;
+                    this->freeList = result->next;
+                    return result;
+                }
+
+                if (this->free == this->end)
+                {
+                    this->blocks.reserve(this->blocks.size() + 1);
+                    this->free = new Cell[this->blockSize];
+                    this->end = this->free + this->blockSize;
+                    this->blocks.push_back(this->free);
+
+                    this->blockSize = std::min(2 * this->blockSize, consts::POOL_MAX_BLOCK);
+                }
+
+                return this->free++;
+            }
+
+        public:
+            static constexpr bool releasesAll = true;
+
+            AllocatorPool() = default;
+
+            AllocatorPool(const AllocatorPool &other) = delete;
+            AllocatorPool &operator=(const AllocatorPool &other) = delete;
+
+            template <class... Targs>
+            Tnode *create(Targs &&...args) noexcept(false)
+            {
+                Cell *cell = this->cell();
+
+                try
+                {
+                    return new (cell->node) Tnode(std::forward<Targs>(args)...);
+                }
+                catch (...)
+                {
+                    cell->next = this->freeList;
+                    this->freeList = cell;
+                    throw;
+                }
+            }
+
+            void destroy(Tnode *node) noexcept
+            {
+                node->~Tnode();
+
+                Cell *cell = reinterpret_cast<Cell *>(node);
+                cell->next = this->freeList;
+                this->freeList = cell;
+            }
+
+            void release() noexcept
+            {
+                for (Cell *block : this->blocks)
+                    delete[] block;
+
+                this->blocks.clear();
+                this->freeList = nullptr;
+                this->free = nullptr;
+                this->end = nullptr;
+                this->blockSize = consts::POOL_FIRST_BLOCK;
+            }
+
+            // Number of the blocks allocated.
+            consts::t_uIndex blockCount() const noexcept
+            {
+                return static_cast<consts::t_uIndex>(this->blocks.size());
+            }
+
+            ~AllocatorPool()
+            {
+                this->release();
+            }
+        };
+    }
+}
+
+#endif
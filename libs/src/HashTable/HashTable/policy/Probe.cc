@@ -0,0 +1,39 @@
+#ifndef __HashTable_policy_Probe_Class__
+#define __HashTable_policy_Probe_Class__
+
+namespace HashTable
+{
+    /**
+     * Probe strategies of open addressing:
+     * static t_uIndex next(capacityPolicy, index, step) - slot after "index" at the step "step" (from 1) of the sequence.
+     */
+    namespace policy
+    {
+        namespace consts
+        {
+            using t_uIndex = unsigned int;
+        }
+
+        struct ProbeLinear
+        {
+            template <class Tcapacity>
+            static consts::t_uIndex next(const Tcapacity &capacityPolicy, const consts::t_uIndex &index, const consts::t_uIndex &) noexcept
+            {
+                return capacityPolicy.next(index);
+            }
+        };
+
+        // Steps 1, 2, 3, ... from the previous slot (triangular numbers from the home slot): breaks up
+        // primary clusters. Visits every slot only for power of two capacities (CapacityPowerOfTwo).
+        struct ProbeTriangular
+        {
+            template <class Tcapacity>
+            static consts::t_uIndex next(const Tcapacity &capacityPolicy, const consts::t_uIndex &index, const consts::t_uIndex &step) noexcept
+            {
+                return capacityPolicy.advance(index, step);
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef __HashTable_policy_Transparent_Class__
+#define __HashTable_policy_Transparent_Class__
+
+#include <type_traits>
+
+namespace HashTable
+{
+    /**
+     * Heterogeneous lookup: search/containsKey/erase/remove also take a key of another type
+     * (e.g. std::string_view or a C string for std::string keys) when the hash function and the
+     * key equality declare "using is_transparent = void;". Such a key must hash the same as the
+     * equal Tkey and be comparable with it, no Tkey is built for the lookup.
+     */
+    namespace policy
+    {
+        template <class T, class = void>
+        struct isTransparent : std::false_type
+        {
+        };
+
+        template <class T>
+        struct isTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type
+        {
+        };
+
+        // Enables a lookup overload for the key type Tother, Tkey itself takes the ordinary one.
+        template <class Tkey, class Tother, class Thash, class Tequal>
+        using enableTransparent = typename std::enable_if<isTransparent<Thash>::value && isTransparent<Tequal>::value && !std::is_same<Tother, Tkey>::value>::type;
+    }
+}
+
+#endif
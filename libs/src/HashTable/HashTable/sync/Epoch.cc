@@ -0,0 +1,146 @@
+#ifndef __HashTable_sync_Epoch_Class__
+#define __HashTable_sync_Epoch_Class__
+
+#include <atomic>
+
+namespace HashTable
+{
+    namespace sync
+    {
+        namespace consts
+        {
+            using t_epoch = unsigned long long;
+        }
+
+        /**
+         * Epoch-based reclamation for the lock-free readers of a table. A reader holds an
+         * Epoch::Guard while it uses memory the writer may replace; the writer unpublishes the
+         * memory, takes retire() and frees it once safe(retired) says no reader can still see it.
+         *
+         * Every thread gets one record of the process-wide list the first time it reads, the record
+         * is on its own cache line and only its thread writes it, so readers do not share lines.
+         * Records of finished threads are reused by new ones.
+         */
+        class Epoch
+        {
+        private:
+            struct alignas(64) Record
+            {
+                // Epoch the reader entered at, 0 outside of a guard.
+                std::atomic<consts::t_epoch> epoch;
+                std::atomic<bool> used;
+                Record *next;
+                unsigned int depth;
+
+                Record() : epoch(0), used(true), next(nullptr), depth(0) {}
+            };
+
+            // Gives the record back when its thread ends.
+            struct Owner
+            {
+                Record *record;
+
+                Owner() : record(Epoch::acquire()) {}
+
+                ~Owner()
+                {
+                    record->used.store(false, std::memory_order_release);
+                }
+            };
+
+            static std::atomic<consts::t_epoch> &global() noexcept
+            {
+                static std::atomic<consts::t_epoch> epoch(1);
+                return epoch;
+            }
+
+            static std::atomic<Record *> &records() noexcept
+            {
+                static std::atomic<Record *> head(nullptr);
+                return head;
+            }
+
+            static Record *acquire()
+            {
+                for (Record *record = records().load(std::memory_order_acquire); record; record = record->next)
+                {
+                    bool used = false;
+
+                    if (!record->used.load(std::memory_order_relaxed) && record->used.compare_exchange_strong(used, true, std::memory_order_acquire))
+                        return record;
+                }
+
+                // The records are never freed, the list only grows up to the largest number of reading threads.
+                Record *record = new Record();
+                Record *head = records().load(std::memory_order_relaxed);
+
+                do
+                    record->next = head;
+                while (!records().compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+                return record;
+            }
+
+            static Record *threadRecord()
+            {
+                thread_local Owner owner;
+                return owner.record;
+            }
+
+        public:
+            // Nested guards of one thread are allowed, the outermost one sets the epoch.
+            class Guard
+            {
+            private:
+                Record *record;
+
+            public:
+                Guard() : record(Epoch::threadRecord())
+                {
+                    if (record->depth++)
+                        return;
+
+                    // Acquire: a reader that sees the epoch of a retire() also sees the pointer stored before it.
+                    record->epoch.store(global().load(std::memory_order_acquire), std::memory_order_relaxed);
+
+                    // The epoch is visible to the writer before the reader loads any pointer.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+
+                Guard(const Guard &other) = delete;
+                Guard &operator=(const Guard &other) = delete;
+
+                ~Guard()
+                {
+                    if (!--record->depth)
+                        record->epoch.store(0, std::memory_order_release);
+                }
+            };
+
+            // Call after the memory is unpublished: the epoch to pass to safe() for it.
+            static consts::t_epoch retire() noexcept
+            {
+                return global().fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            // No reader that entered at or before the epoch "retired" is still inside its guard.
+            static bool safe(const consts::t_epoch &retired) noexcept
+            {
+                // Pairs with the fence of Guard: either the reader's epoch is seen here or the reader sees the new pointer.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                for (Record *record = records().load(std::memory_order_acquire); record; record = record->next)
+                {
+                    consts::t_epoch epoch = record->epoch.load(std::memory_order_acquire);
+
+                    if (epoch && epoch <= retired)
+                        return false;
+                }
+
+                return true;
+            }
+        };
+    }
+}
+
+#endif
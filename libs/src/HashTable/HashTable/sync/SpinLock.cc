@@ -0,0 +1,71 @@
+#ifndef __HashTable_sync_SpinLock_Class__
+#define __HashTable_sync_SpinLock_Class__
+
+#include <atomic>
+
+namespace HashTable
+{
+    namespace sync
+    {
+        /**
+         * Test-and-test-and-set spin lock for short critical sections. It has the shared interface
+         * of std::shared_mutex (lock_shared takes the lock exclusively), so it can replace one
+         * where readers are not worth a reader-writer lock.
+         */
+        class SpinLock
+        {
+        private:
+            std::atomic<bool> locked;
+
+            static void pause() noexcept
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+
+        public:
+            SpinLock() noexcept : locked(false) {}
+
+            SpinLock(const SpinLock &other) = delete;
+            SpinLock &operator=(const SpinLock &other) = delete;
+
+            bool try_lock() noexcept
+            {
+                return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+            }
+
+            void lock() noexcept
+            {
+                // Waiting threads only read the flag, the cache line stays shared until it is released.
+                while (!this->try_lock())
+                {
+                    while (locked.load(std::memory_order_relaxed))
+                        pause();
+                }
+            }
+
+            void unlock() noexcept
+            {
+                locked.store(false, std::memory_order_release);
+            }
+
+            void lock_shared() noexcept
+            {
+                this->lock();
+            }
+
+            bool try_lock_shared() noexcept
+            {
+                return this->try_lock();
+            }
+
+            void unlock_shared() noexcept
+            {
+                this->unlock();
+            }
+        };
+    }
+}
+
+#endif
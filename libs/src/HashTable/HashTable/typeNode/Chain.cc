@@ -2,6 +2,10 @@
 #define __HashTable_typeNode_Chain_Class__
 
 #include <string>
+#include <utility>
+
+#include "../policy/KeyEqual.cc"
+#include "StoredHash.cc"
 
 namespace HashTable
 {
@@ -13,24 +17,35 @@ namespace typeNode
         using t_count = unsigned int;
     }   
 
-template <class Tkey, class Tdata>
+// The lookups take the full hash of the key: with cacheHash it is stored in every node
+// and keys are compared only when the hashes are equal. The key of a lookup may be of any
+// type Tequal compares with Tkey.
+// The nodes are made and freed by the allocator of the table (policy/NodeAllocator.cc) that the
+// functions take, the chain does not free them by itself: its owner calls clear(allocator).
+template <class Tkey, class Tdata, class Tequal = policy::KeyEqual<Tkey>, bool cacheHash = false>
 class Chain
 {
     public:
 
-    struct Node
+    struct Node : StoredHash<cacheHash>
     {
         Tkey key;
         Tdata data;
         Node *next;
         Node *prev;
-        Node(const Tkey& key, const Tdata& data) : key(key), data(data), next(nullptr), prev(nullptr) {}
+        // The data is constructed from the arguments in place.
+        template <class Tk, class... Targs>
+        Node(const consts::t_uHash& hash, Tk&& key, Targs&&... args) : StoredHash<cacheHash>(hash), key(std::forward<Tk>(key)), data(std::forward<Targs>(args)...), next(nullptr), prev(nullptr) {}
     };
 
+    // The type the allocator of the table makes.
+    using Allocated = Node;
+
     private:
 
     Node *head;
     consts::t_count _size;
+    Tequal keyEqual;
 
     public:
     
@@ -42,83 +57,135 @@ class Chain
         return this->_size;
     }
 
-    void clear()
+    // First node, nullptr if the chain is empty.
+    Node* front() const
+    {
+        return this->head;
+    }
+
+    template <class Tallocator>
+    void clear(Tallocator& allocator)
     {
         while (head != nullptr)
         {
             Node *temp = head;
             head = head->next;
-            delete temp;
+            allocator.destroy(temp);
         }
 
         head = nullptr;
+        _size = 0;
     }
 
-    ~Chain()
-    {
-        this->clear();
-    }
-
-    void insert(const Tkey& key, const Tdata& data)
+    // Whether the key was added, false if only its data was replaced.
+    template <class Tallocator, class Tk, class Td>
+    bool insert(Tallocator& allocator, const consts::t_uHash& hash, Tk&& key, Td&& data)
     {
         Node *current = head;
         while (current != nullptr)
         {
-            if (current->key == key)
+            if (current->sameHash(hash) && keyEqual(current->key, key))
             {
-                current->data = data;
-                return;
+                current->data = std::forward<Td>(data);
+                return false;
             }
             current = current->next;
         }
 
-        Node *newNode = new Node(key, data);
-        if (head == nullptr)
+        this->push(allocator.create(hash, std::forward<Tk>(key), std::forward<Td>(data)));
+        return true;
+    }
+
+    template <class Tallocator, class Tk, class Td>
+    bool add(Tallocator& allocator, const consts::t_uHash& hash, Tk&& key, Td&& data)
+    {
+        return this->emplace(allocator, hash, std::forward<Tk>(key), std::forward<Td>(data)).second;
+    }
+
+    // Node of the key and whether it was added now. The data is constructed from the arguments
+    // only if the key is absent.
+    template <class Tallocator, class Tk, class... Targs>
+    std::pair<Node*, bool> emplace(Tallocator& allocator, const consts::t_uHash& hash, Tk&& key, Targs&&... args)
+    {
+        Node *current = this->getByKey(hash, key);
+
+        if (current != nullptr)
         {
-            head = newNode;
+            return {current, false};
         }
-        else
+
+        current = allocator.create(hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+        this->push(current);
+        return {current, true};
+    }
+
+    // Adds an element whose key is absent here without a lookup: copies and rebuilds.
+    template <class Tallocator, class Tk, class... Targs>
+    Node* place(Tallocator& allocator, const consts::t_uHash& hash, Tk&& key, Targs&&... args)
+    {
+        Node *node = allocator.create(hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+        this->push(node);
+        return node;
+    }
+
+    // Relinks every node into buckets[index(node)], nothing is copied or allocated.
+    template <class Tallocator, class Tindex>
+    void moveTo(Tallocator&, Chain *buckets, Tindex index)
+    {
+        while (Node *node = this->pop())
         {
-            newNode->next = head;
-            head->prev = newNode;
-            head = newNode;
+            buckets[index(*node)].push(node);
         }
-        ++this->_size;
     }
 
-    bool add(const Tkey& key, const Tdata& data)
+    // Brings in the first node, the lookup reads it right after the bucket.
+    void prefetch() const
     {
-        Node *current = head;
-        while (current != nullptr)
+        if (head != nullptr)
         {
-            if (current->key == key)
-            {
-                return false;
-            }
-            current = current->next;
+            __builtin_prefetch(head);
         }
+    }
 
-        Node *newNode = new Node(key, data);
-        if (head == nullptr)
+    // Links a node that is not in any chain, its key must be absent here. A rebuild moves
+    // nodes between chains this way without allocations and copies.
+    void push(Node *node)
+    {
+        node->prev = nullptr;
+        node->next = head;
+        if (head != nullptr)
         {
-            head = newNode;
+            head->prev = node;
         }
-        else
+        head = node;
+        ++this->_size;
+    }
+
+    // Unlinks the first node and gives it to the caller, nullptr if the chain is empty.
+    Node* pop()
+    {
+        Node *node = head;
+
+        if (node != nullptr)
         {
-            newNode->next = head;
-            head->prev = newNode;
-            head = newNode;
+            head = node->next;
+            if (head != nullptr)
+            {
+                head->prev = nullptr;
+            }
+            node->next = nullptr;
+            --this->_size;
         }
-        ++this->_size;
-        return true;
+        return node;
     }
 
-    bool remove(const Tkey& key)
+    template <class Tallocator, class Tk>
+    bool remove(Tallocator& allocator, const consts::t_uHash& hash, const Tk& key)
     {
         Node *current = head;
         while (current != nullptr)
         {
-            if (current->key == key)
+            if (current->sameHash(hash) && keyEqual(current->key, key))
             {
                 if (current->prev != nullptr) // Удаляем элемент из середины или конца списка
                 {
@@ -132,7 +199,7 @@ class Chain
                 {
                     head = current->next;
                 }
-                delete current;
+                allocator.destroy(current);
                 --this->_size;
                 return true;
             }
@@ -141,12 +208,13 @@ class Chain
         return false;
     }
 
-    Node* getByKey(const Tkey& key) const
+    template <class Tk>
+    Node* getByKey(const consts::t_uHash& hash, const Tk& key) const
     {
         Node *current = head;
         while (current != nullptr)
         {
-            if (current->key == key)
+            if (current->sameHash(hash) && keyEqual(current->key, key))
             {
                 return current;
             }
@@ -155,12 +223,13 @@ class Chain
         return nullptr; // Возвращаем nullptr, если элемент с указанным ключом не найден
     }
 
-    bool contains(const Tkey& key) const
+    template <class Tk>
+    bool contains(const consts::t_uHash& hash, const Tk& key) const
     {
         Node *current = head;
         while (current != nullptr)
         {
-            if (current->key == key)
+            if (current->sameHash(hash) && keyEqual(current->key, key))
             {
                 return true;
             }
@@ -218,8 +287,8 @@ class Chain
         return result;
     }
 
-    template <class Tkey, class Tdata>
-    std::string Chain<Tkey, Tdata>::toString() const
+    template <class Tkey, class Tdata, class Tequal, bool cacheHash>
+    std::string Chain<Tkey, Tdata, Tequal, cacheHash>::toString() const
     {
         std::string result;
 
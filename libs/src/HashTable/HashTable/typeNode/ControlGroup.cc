@@ -0,0 +1,105 @@
+#ifndef __HashTable_typeNode_ControlGroup_Class__
+#define __HashTable_typeNode_ControlGroup_Class__
+
+#include "OpenAddressingFlat.cc"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace HashTable
+{
+    namespace typeNode
+    {
+        namespace consts
+        {
+            using t_bitMask = unsigned int;
+            using t_occupancy = unsigned long long;
+
+            const t_count GROUP_SIZE = 16;
+
+            // Slots of one occupancy word, see ControlGroup::occupancy.
+            const t_count OCCUPANCY_WORD = 64;
+        }
+
+        /**
+         * Sixteen control bytes of OpenAddressingFlat compared at once (SSE2, with a scalar fallback).
+         * Every match returns a bit mask: bit i is set when byte i matches.
+         */
+        class ControlGroup
+        {
+        private:
+#ifdef __SSE2__
+            __m128i controls;
+#else
+            const consts::t_control *controls;
+#endif
+
+        public:
+#ifdef __SSE2__
+            explicit ControlGroup(const consts::t_control *controls) noexcept : controls(_mm_loadu_si128(reinterpret_cast<const __m128i *>(controls))) {}
+
+            consts::t_bitMask match(const consts::t_control &control) const noexcept
+            {
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(control)), controls));
+            }
+
+            // Empty slots and tombstones, i.e. control bytes with the high bit set.
+            consts::t_bitMask matchFree() const noexcept
+            {
+                return _mm_movemask_epi8(controls);
+            }
+#else
+            explicit ControlGroup(const consts::t_control *controls) noexcept : controls(controls) {}
+
+            consts::t_bitMask match(const consts::t_control &control) const noexcept
+            {
+                consts::t_bitMask result = 0;
+
+                for (consts::t_count i = 0; i < consts::GROUP_SIZE; ++i)
+                    result |= static_cast<consts::t_bitMask>(controls[i] == control) << i;
+
+                return result;
+            }
+
+            consts::t_bitMask matchFree() const noexcept
+            {
+                consts::t_bitMask result = 0;
+
+                for (consts::t_count i = 0; i < consts::GROUP_SIZE; ++i)
+                    result |= static_cast<consts::t_bitMask>(controls[i] >> 7) << i;
+
+                return result;
+            }
+#endif
+
+            consts::t_bitMask matchEmpty() const noexcept
+            {
+                return this->match(consts::CONTROL_EMPTY);
+            }
+
+            static consts::t_count lowestBit(const consts::t_bitMask &mask) noexcept
+            {
+                return __builtin_ctz(mask);
+            }
+
+            // Occupancy bitmap of the OCCUPANCY_WORD slots from "first": bit i is set when slot first + i
+            // (below capacity) is occupied. Whole groups are read at once, the slots of a last partial group one by one.
+            static consts::t_occupancy occupancy(const consts::t_control *controls, const consts::t_count &first, const consts::t_count &capacity) noexcept
+            {
+                consts::t_occupancy result = 0;
+                consts::t_count i = 0;
+
+                for (; i < consts::OCCUPANCY_WORD && first + i + consts::GROUP_SIZE <= capacity; i += consts::GROUP_SIZE)
+                    result |= static_cast<consts::t_occupancy>(~ControlGroup(controls + first + i).matchFree() & 0xFFFF) << i;
+
+                for (; i < consts::OCCUPANCY_WORD && first + i < capacity; ++i)
+                    result |= static_cast<consts::t_occupancy>(!(controls[first + i] & consts::CONTROL_EMPTY)) << i;
+
+                return result;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef __HashTable_typeNode_OpenAddressingFlat_Class__
+#define __HashTable_typeNode_OpenAddressingFlat_Class__
+
+#include <cstdint>
+#include <new>
+#include <cstring>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "StoredHash.cc"
+
+namespace HashTable
+{
+    namespace typeNode
+    {
+        namespace consts
+        {
+            using t_count = unsigned int;
+            using t_control = unsigned char;
+
+            // Control byte of a slot: high bit set - slot is free, high bit clear - slot is occupied.
+            // The low 7 bits of an occupied slot are free for a fingerprint of the key hash.
+            const t_control CONTROL_EMPTY = 0x80;
+            const t_control CONTROL_TOMBSTONE = 0xFE;
+            const t_control CONTROL_OCCUPIED = 0x00;
+        }
+
+        /**
+         * Flat storage of slots for open addressing: key and data of a slot lie side by side
+         * in one contiguous array, state of every slot is kept in a separate byte array.
+         * No memory is allocated per element.
+         *
+         * With cacheHash the full hash of the key is kept in the slot (see StoredHash).
+         */
+        template <class Tkey, class Tdata, bool cacheHash = false>
+        class OpenAddressingFlat
+        {
+        public:
+            struct Slot : StoredHash<cacheHash>
+            {
+                Tkey key;
+                Tdata data;
+
+                // The data is constructed from the arguments in place.
+                template <class Tk, class... Targs>
+                Slot(const consts::t_uHash &hash, Tk &&key, Targs &&...args) : StoredHash<cacheHash>(hash), key(std::forward<Tk>(key)), data(std::forward<Targs>(args)...) {}
+            };
+
+        private:
+            Slot *slots;
+            consts::t_control *controls;
+            consts::t_count _capacity;
+
+        public:
+            OpenAddressingFlat() : slots(nullptr), controls(nullptr), _capacity(0) {}
+
+            explicit OpenAddressingFlat(const consts::t_count &capacity) noexcept(false) : OpenAddressingFlat(capacity, true) {}
+
+            // Slots with the control bytes left unset when setControls is false: prepare has to set every
+            // one of them before any other use, and until then only release() may free the array.
+            OpenAddressingFlat(const consts::t_count &capacity, const bool &setControls) noexcept(false) : slots(nullptr), controls(nullptr), _capacity(0)
+            {
+                if (!capacity)
+                    return;
+
+                slots = static_cast<Slot *>(::operator new(sizeof(Slot) * capacity));
+                controls = new consts::t_control[capacity];
+                _capacity = capacity;
+
+                if (setControls)
+                    std::memset(controls, consts::CONTROL_EMPTY, capacity);
+            }
+
+            OpenAddressingFlat(const OpenAddressingFlat &other) = delete;
+            OpenAddressingFlat &operator=(const OpenAddressingFlat &other) = delete;
+
+            consts::t_count capacity() const noexcept
+            {
+                return this->_capacity;
+            }
+
+            bool allocated() const noexcept
+            {
+                return this->slots;
+            }
+
+            consts::t_control getControl(const consts::t_count &index) const noexcept
+            {
+                return controls[index];
+            }
+
+            void setControl(const consts::t_count &index, const consts::t_control &control) noexcept
+            {
+                controls[index] = control;
+            }
+
+            const consts::t_control *getControls() const noexcept
+            {
+                return controls;
+            }
+
+            bool isEmpty(const consts::t_count &index) const noexcept
+            {
+                return controls[index] == consts::CONTROL_EMPTY;
+            }
+
+            bool isTombstone(const consts::t_count &index) const noexcept
+            {
+                return controls[index] == consts::CONTROL_TOMBSTONE;
+            }
+
+            bool isOccupied(const consts::t_count &index) const noexcept
+            {
+                return !(controls[index] & consts::CONTROL_EMPTY);
+            }
+
+            Tkey &getKey(const consts::t_count &index) const noexcept
+            {
+                return slots[index].key;
+            }
+
+            Tdata &getData(const consts::t_count &index) const noexcept
+            {
+                return slots[index].data;
+            }
+
+            Slot &getSlot(const consts::t_count &index) const noexcept
+            {
+                return slots[index];
+            }
+
+            // Full hash of the key of an occupied slot, only with cacheHash.
+            consts::t_uHash getHash(const consts::t_count &index) const noexcept
+            {
+                static_assert(cacheHash, "the hash is stored only with cacheHash");
+                return slots[index].hash;
+            }
+
+            // False only if the hash is stored and differs: the keys are surely different.
+            bool sameHash(const consts::t_count &index, const consts::t_uHash &hash) const noexcept
+            {
+                return slots[index].sameHash(hash);
+            }
+
+            // Brings the control byte and the slot into the cache ahead of a probe.
+            void prefetch(const consts::t_count &index) const noexcept
+            {
+                __builtin_prefetch(controls + index);
+                __builtin_prefetch(slots + index);
+            }
+
+            bool equalKey(const consts::t_count &index, const Tkey &key) const noexcept
+            {
+                return this->isOccupied(index) && slots[index].key == key;
+            }
+
+            // The slot must not be occupied.
+            template <class Tk, class Td>
+            void set(const consts::t_count &index, Tk &&key, Td &&data, const consts::t_control &control = consts::CONTROL_OCCUPIED) noexcept(false)
+            {
+                this->construct(index, control, 0, std::forward<Tk>(key), std::forward<Td>(data));
+            }
+
+            // The slot must not be occupied. Key and data are moved in or constructed in place, the data from the arguments.
+            template <class Tk, class... Targs>
+            void construct(const consts::t_count &index, const consts::t_control &control, const consts::t_uHash &hash, Tk &&key, Targs &&...args) noexcept(false)
+            {
+                new (&slots[index]) Slot(hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+                controls[index] = control;
+            }
+
+            template <class Td>
+            void setData(const consts::t_count &index, Td &&data) noexcept(false)
+            {
+                slots[index].data = std::forward<Td>(data);
+            }
+
+            // Destroys the element and leaves a tombstone by default, so probe sequences running through the slot stay intact.
+            void erase(const consts::t_count &index, const consts::t_control &control = consts::CONTROL_TOMBSTONE) noexcept
+            {
+                slots[index].~Slot();
+                controls[index] = control;
+            }
+
+            // Moves the element of the slot "from" into the free slot "to", the slot "from" becomes empty.
+            void relocate(const consts::t_count &to, const consts::t_count &from, const consts::t_control &control) noexcept
+            {
+                new (&slots[to]) Slot(std::move(slots[from]));
+                controls[to] = control;
+
+                slots[from].~Slot();
+                controls[from] = consts::CONTROL_EMPTY;
+            }
+
+            void swap(OpenAddressingFlat &other) noexcept
+            {
+                Slot *tmpSlots = this->slots;
+                this->slots = other.slots;
+                other.slots = tmpSlots;
+
+                consts::t_control *tmpControls = this->controls;
+                this->controls = other.controls;
+                other.controls = tmpControls;
+
+                consts::t_count tmpCapacity = this->_capacity;
+                this->_capacity = other._capacity;
+                other._capacity = tmpCapacity;
+            }
+
+            // Marks "count" slots from "first" empty, see the constructor with setControls, and writes
+            // their memory once: its pages are mapped now rather than on the first writes of the elements.
+            void prepare(const consts::t_count &first, const consts::t_count &count) noexcept
+            {
+                std::memset(controls + first, consts::CONTROL_EMPTY, count);
+                std::memset(static_cast<void *>(slots + first), 0, sizeof(Slot) * count);
+            }
+
+            // Hands the memory of the whole pages among "count" slots from "first" back to the system, so
+            // freeing the array later has less to unmap. The slots must not be occupied and their memory
+            // is not read again; the control bytes stay. Linux only (madvise), elsewhere it does nothing.
+            void discard(const consts::t_count &first, const consts::t_count &count) noexcept
+            {
+#ifdef __linux__
+                static const std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+
+                std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(slots + first) + page - 1) & ~(page - 1);
+                std::uintptr_t end = reinterpret_cast<std::uintptr_t>(slots + first + count) & ~(page - 1);
+
+                if (begin < end)
+                    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+#else
+                (void)first;
+                (void)count;
+#endif
+            }
+
+            // Frees the arrays without a look at the slots, O(1): no slot may be occupied, e.g. every element
+            // was moved out, or the control bytes may be unset.
+            void release() noexcept
+            {
+                ::operator delete(slots);
+                delete[] controls;
+
+                slots = nullptr;
+                controls = nullptr;
+                _capacity = 0;
+            }
+
+            void clear() noexcept
+            {
+                if (!slots)
+                    return;
+
+                for (consts::t_count i = 0; i < _capacity; ++i)
+                {
+                    if (this->isOccupied(i))
+                        slots[i].~Slot();
+                }
+
+                ::operator delete(slots);
+                delete[] controls;
+
+                slots = nullptr;
+                controls = nullptr;
+                _capacity = 0;
+            }
+
+            ~OpenAddressingFlat()
+            {
+                this->clear();
+            }
+        };
+    }
+}
+
+#endif
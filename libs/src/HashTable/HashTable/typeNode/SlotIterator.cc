@@ -0,0 +1,117 @@
+#ifndef __HashTable_typeNode_SlotIterator_Class__
+#define __HashTable_typeNode_SlotIterator_Class__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "ControlGroup.cc"
+#include "OpenAddressingFlat.cc"
+
+namespace HashTable
+{
+    namespace typeNode
+    {
+        /**
+         * Forward iterator over the occupied slots of an OpenAddressingFlat, and then of a second one
+         * (the old array of an incremental rehash) if it is given. Yields the Slot, with key and data.
+         *
+         * Free slots are skipped OCCUPANCY_WORD at a time: ControlGroup::occupancy turns the control
+         * bytes into an occupancy bitmap word and the lowest set bit is the next element, so a sparse
+         * table costs a group load per 16 slots and a step per element. Any change of the table
+         * invalidates the iterator.
+         */
+        template <class Tflat, bool isConst>
+        class SlotIterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename Tflat::Slot;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<isConst, const value_type *, value_type *>::type;
+            using reference = typename std::conditional<isConst, const value_type &, value_type &>::type;
+
+        private:
+            const Tflat *table;
+            const Tflat *rest;
+            consts::t_count first;
+            consts::t_occupancy word;
+
+            // Moves to the next occupied slot from the current word on, to the end if there is none.
+            void settle() noexcept
+            {
+                while (!this->word && this->table)
+                {
+                    this->first += consts::OCCUPANCY_WORD;
+
+                    if (this->first >= this->table->capacity())
+                    {
+                        this->table = this->rest;
+                        this->rest = nullptr;
+                        this->first = 0;
+
+                        if (!this->table)
+                            return;
+                    }
+
+                    this->word = ControlGroup::occupancy(this->table->getControls(), this->first, this->table->capacity());
+                }
+            }
+
+        public:
+            // The end iterator.
+            SlotIterator() noexcept : table(nullptr), rest(nullptr), first(0), word(0) {}
+
+            SlotIterator(const Tflat *table, const Tflat *rest) noexcept : table(table), rest(rest), first(0), word(0)
+            {
+                if (this->table->capacity())
+                    this->word = ControlGroup::occupancy(this->table->getControls(), 0, this->table->capacity());
+
+                this->settle();
+            }
+
+            // A const iterator from an iterator.
+            template <bool otherConst, class = typename std::enable_if<isConst && !otherConst>::type>
+            SlotIterator(const SlotIterator<Tflat, otherConst> &other) noexcept : table(other.table), rest(other.rest), first(other.first), word(other.word) {}
+
+            reference operator*() const noexcept
+            {
+                return this->table->getSlot(this->first + __builtin_ctzll(this->word));
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &**this;
+            }
+
+            SlotIterator &operator++() noexcept
+            {
+                this->word &= this->word - 1;
+                this->settle();
+                return *this;
+            }
+
+            SlotIterator operator++(int) noexcept
+            {
+                SlotIterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const SlotIterator &other) const noexcept
+            {
+                return this->table == other.table && this->first == other.first && this->word == other.word;
+            }
+
+            bool operator!=(const SlotIterator &other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+            template <class, bool>
+            friend class SlotIterator;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __HashTable_typeNode_StoredHash_Class__
+#define __HashTable_typeNode_StoredHash_Class__
+
+namespace HashTable
+{
+    namespace typeNode
+    {
+        namespace consts
+        {
+            using t_uHash = unsigned long long;
+        }
+
+        /**
+         * Full hash of the key kept next to an element, a base of the slot and node types.
+         * With cached = false it is empty and takes no space, every hash compare succeeds.
+         */
+        template <bool cached>
+        struct StoredHash
+        {
+            StoredHash(const consts::t_uHash &) noexcept {}
+
+            bool sameHash(const consts::t_uHash &) const noexcept
+            {
+                return true;
+            }
+        };
+
+        template <>
+        struct StoredHash<true>
+        {
+            consts::t_uHash hash;
+
+            StoredHash(const consts::t_uHash &hash) noexcept : hash(hash) {}
+
+            bool sameHash(const consts::t_uHash &hash) const noexcept
+            {
+                return this->hash == hash;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef __HashTable_typeNode_UnrolledBucket_Class__
+#define __HashTable_typeNode_UnrolledBucket_Class__
+
+#include <new>
+#include <string>
+#include <utility>
+
+#include "../HashTableBase.cc"
+#include "../policy/KeyEqual.cc"
+#include "Chain.cc"
+#include "StoredHash.cc"
+
+namespace HashTable
+{
+    namespace typeNode
+    {
+        namespace consts
+        {
+            const t_count CACHE_LINE = 64;
+        }
+
+        /**
+         * Bucket of the chain method with the same interface as Chain: the first elements are stored
+         * in the bucket itself, a cache line (or a few for large elements) with as many elements as
+         * fit next to a counter and a pointer, the rest go to linked overflow blocks of the same layout
+         * made by the allocator of the table. A lookup in a bucket that did not overflow touches one
+         * cache line and no node.
+         *
+         * Every block but the last is full: a remove moves the last element into the hole and the last
+         * block is freed when it empties. So the elements move on remove and on reCapacity, a pointer to
+         * an element stays valid only until the next change of the table.
+         */
+        template <class Tkey, class Tdata, class Tequal = policy::KeyEqual<Tkey>, bool cacheHash = false>
+        class UnrolledBucket
+        {
+        public:
+            struct Node : StoredHash<cacheHash>
+            {
+                Tkey key;
+                Tdata data;
+
+                template <class Tk, class... Targs>
+                Node(const consts::t_uHash &hash, Tk &&key, Targs &&...args) : StoredHash<cacheHash>(hash), key(std::forward<Tk>(key)), data(std::forward<Targs>(args)...) {}
+            };
+
+            // Elements of a block: as many as fit in a cache line next to the counter and the pointer, at least one.
+            static constexpr consts::t_count BLOCK_SIZE = sizeof(Node) + sizeof(void *) + sizeof(consts::t_count) <= consts::CACHE_LINE ? (consts::CACHE_LINE - sizeof(void *) - sizeof(consts::t_count)) / sizeof(Node) : 1;
+
+            struct alignas(consts::CACHE_LINE) Block
+            {
+                alignas(Node) unsigned char nodes[BLOCK_SIZE][sizeof(Node)];
+                consts::t_count count;
+                Block *next;
+
+                Block() noexcept : count(0), next(nullptr) {}
+
+                Node *at(const consts::t_count &index) noexcept
+                {
+                    return std::launder(reinterpret_cast<Node *>(nodes[index]));
+                }
+
+                const Node *at(const consts::t_count &index) const noexcept
+                {
+                    return std::launder(reinterpret_cast<const Node *>(nodes[index]));
+                }
+            };
+
+            // The type the allocator of the table makes.
+            using Allocated = Block;
+
+        private:
+            // No Tequal member: it would make the bucket larger than its blocks.
+            Block head;
+
+            Block *last() noexcept
+            {
+                Block *block = &this->head;
+
+                while (block->next != nullptr)
+                    block = block->next;
+
+                return block;
+            }
+
+            // The key must be absent.
+            template <class Tallocator, class... Targs>
+            Node *append(Tallocator &allocator, Targs &&...args)
+            {
+                Block *block = this->last();
+
+                if (block->count == BLOCK_SIZE)
+                {
+                    block->next = allocator.create();
+                    block = block->next;
+                }
+
+                Node *node = new (block->nodes[block->count]) Node(std::forward<Targs>(args)...);
+                ++block->count;
+                return node;
+            }
+
+            template <class Tk>
+            Node *find(const consts::t_uHash &hash, const Tk &key) const
+            {
+                Tequal keyEqual;
+
+                for (const Block *block = &this->head; block != nullptr; block = block->next)
+                {
+                    for (consts::t_count i = 0; i < block->count; ++i)
+                    {
+                        const Node *node = block->at(i);
+
+                        if (node->sameHash(hash) && keyEqual(node->key, key))
+                            return const_cast<Node *>(node);
+                    }
+                }
+
+                return nullptr;
+            }
+
+        public:
+            UnrolledBucket() = default;
+
+            consts::t_count size() const
+            {
+                consts::t_count result = 0;
+
+                for (const Block *block = &this->head; block != nullptr; block = block->next)
+                    result += block->count;
+
+                return result;
+            }
+
+            template <class Tallocator>
+            void clear(Tallocator &allocator)
+            {
+                for (consts::t_count i = 0; i < this->head.count; ++i)
+                    this->head.at(i)->~Node();
+
+                Block *block = this->head.next;
+
+                while (block != nullptr)
+                {
+                    Block *next = block->next;
+
+                    for (consts::t_count i = 0; i < block->count; ++i)
+                        block->at(i)->~Node();
+
+                    allocator.destroy(block);
+                    block = next;
+                }
+
+                this->head.count = 0;
+                this->head.next = nullptr;
+            }
+
+            // Whether the key was added, false if only its data was replaced.
+            template <class Tallocator, class Tk, class Td>
+            bool insert(Tallocator &allocator, const consts::t_uHash &hash, Tk &&key, Td &&data)
+            {
+                Node *node = this->find(hash, key);
+
+                if (node != nullptr)
+                {
+                    node->data = std::forward<Td>(data);
+                    return false;
+                }
+
+                this->append(allocator, hash, std::forward<Tk>(key), std::forward<Td>(data));
+                return true;
+            }
+
+            template <class Tallocator, class Tk, class Td>
+            bool add(Tallocator &allocator, const consts::t_uHash &hash, Tk &&key, Td &&data)
+            {
+                return this->emplace(allocator, hash, std::forward<Tk>(key), std::forward<Td>(data)).second;
+            }
+
+            template <class Tallocator, class Tk, class... Targs>
+            std::pair<Node *, bool> emplace(Tallocator &allocator, const consts::t_uHash &hash, Tk &&key, Targs &&...args)
+            {
+                Node *node = this->find(hash, key);
+
+                if (node != nullptr)
+                    return {node, false};
+
+                return {this->append(allocator, hash, std::forward<Tk>(key), std::forward<Targs>(args)...), true};
+            }
+
+            // Adds an element whose key is absent here without a lookup, see Chain::place.
+            template <class Tallocator, class Tk, class... Targs>
+            Node *place(Tallocator &allocator, const consts::t_uHash &hash, Tk &&key, Targs &&...args)
+            {
+                return this->append(allocator, hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+            }
+
+            template <class Tallocator, class Tk>
+            bool remove(Tallocator &allocator, const consts::t_uHash &hash, const Tk &key)
+            {
+                Node *node = this->find(hash, key);
+
+                if (node == nullptr)
+                    return false;
+
+                Block *previous = nullptr;
+                Block *block = &this->head;
+
+                while (block->next != nullptr)
+                {
+                    previous = block;
+                    block = block->next;
+                }
+
+                Node *moved = block->at(block->count - 1);
+
+                if (moved != node)
+                    *node = std::move(*moved);
+
+                moved->~Node();
+
+                if (--block->count == 0 && previous != nullptr)
+                {
+                    previous->next = nullptr;
+                    allocator.destroy(block);
+                }
+
+                return true;
+            }
+
+            template <class Tk>
+            Node *getByKey(const consts::t_uHash &hash, const Tk &key) const
+            {
+                return this->find(hash, key);
+            }
+
+            template <class Tk>
+            bool contains(const consts::t_uHash &hash, const Tk &key) const
+            {
+                return this->find(hash, key) != nullptr;
+            }
+
+            // Brings in the first overflow block, the bucket itself is the cache line of the lookup.
+            void prefetch() const noexcept
+            {
+                if (this->head.next != nullptr)
+                    __builtin_prefetch(this->head.next);
+            }
+
+            // Moves every element into buckets[index(node)] and empties this bucket, see ChainMethodBase::rebuild.
+            template <class Tallocator, class Tindex>
+            void moveTo(Tallocator &allocator, UnrolledBucket *buckets, Tindex index)
+            {
+                for (Block *block = &this->head; block != nullptr; block = block->next)
+                {
+                    for (consts::t_count i = 0; i < block->count; ++i)
+                    {
+                        Node *node = block->at(i);
+                        buckets[index(*node)].append(allocator, std::move(*node));
+                    }
+                }
+
+                this->clear(allocator);
+            }
+
+            class Iterator
+            {
+            private:
+                Block *block;
+                consts::t_count index;
+
+            public:
+                Iterator(Block *block) : block(block), index(0) {}
+
+                Node &operator*() const { return *block->at(index); }
+
+                Iterator &operator++()
+                {
+                    if (++index == block->count)
+                    {
+                        block = block->next;
+                        index = 0;
+                    }
+                    return *this;
+                }
+
+                bool operator!=(const Iterator &other) const
+                {
+                    return block != other.block || index != other.index;
+                }
+            };
+
+            // Only the head may be empty, then there is no next block.
+            Iterator begin() const { return Iterator(this->head.count ? const_cast<Block *>(&this->head) : nullptr); }
+            Iterator end() const { return Iterator(nullptr); }
+
+            std::string toString() const
+            {
+                std::string result;
+
+                result += "UnrolledBucket: {\n";
+
+                for (const Node &item : *this)
+                    result += "\tkey:" + tools::toString(item.key) + ", data:" + tools::toString(item.data) + ",\n";
+
+                result += "};";
+                return result;
+            }
+        };
+    }
+}
+
+#endif
@@ -1,143 +1,737 @@
 #ifndef __HashTable_LinearProbing_Class__
 #define __HashTable_LinearProbing_Class__
 
-#include "HashFunctions/FunctionModulus.cc"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 #include "HashTable/OpenAddressingBase.cc"
-#include "HashTable/typeNode/OpenAddressing.cc"
+#include "HashTable/Serialization.cc"
+#include "HashTable/policy/Capacity.cc"
+#include "HashTable/policy/KeyEqual.cc"
+#include "HashTable/policy/Probe.cc"
+#include "HashTable/policy/Transparent.cc"
+#include "HashTable/typeNode/OpenAddressingFlat.cc"
 
 namespace HashTable
 {
 
-    template <class Tkey, class Tdata>
-    class LinearProbing : public OpenAddressingBase<Tkey, Tdata>
+    /**
+     * @tparam Tcapacity capacity policy from HashTable::policy: CapacityModulus (odd capacities, the default),
+     * CapacityPowerOfTwo (mask-based indexing) or CapacityFastModulus (prime capacities without divisions).
+     * The hash function is the one of the capacity policy.
+     * @tparam Tequal key equality, policy::KeyEqual compares keys with ==.
+     * @tparam Tprobe probe sequence: policy::ProbeLinear or policy::ProbeTriangular (with CapacityPowerOfTwo only).
+     * @tparam cacheHash keep the full hash in every slot: fewer key compares, reCapacity does not hash
+     * the keys again, at the cost of 8 bytes per slot. Pays off for keys that are expensive to hash or compare.
+     *
+     * An erase leaves a tombstone. Tombstones count with the elements against loadFactorMax, so that a
+     * miss still finds an empty slot; when they push the table over it, it is rebuilt at the same capacity.
+     *
+     * With setIncrementalRehash(true) reCapacity does not rebuild the table at once. The new slot array
+     * is prepared INCREMENTAL_REHASH_CLEAR bytes per operation first; then the old array
+     * is kept and every following insert/erase/add/remove moves a few of its slots to the new one, at
+     * least INCREMENTAL_REHASH_STEP and enough to be done before the new array fills up. Lookups check
+     * both arrays until the old one is empty, and the old array is freed without a pass over it. A
+     * shrink waits till a move is done. The costs that stay O(capacity) in one operation: the memory
+     * allocator itself (the system maps and unmaps large arrays, the unmapping in time proportional to
+     * the pages touched), and reserve/rehash, which finish a move and rebuild at once as asked.
+     * The latencies of both modes are in benchmark/ResizeLatency.cpp.
+     *
+     * search/containsKey/erase/remove also take a key of another type when the hash function and Tequal
+     * are transparent (policy/Transparent.cc): std::string tables with the bundled string hashes are
+     * queried by std::string_view or a C string without building a std::string.
+     */
+    template <class Tkey, class Tdata, class Tcapacity = policy::CapacityModulus<Tkey>, class Tequal = policy::KeyEqual<Tkey>, class Tprobe = policy::ProbeLinear, bool cacheHash = false>
+    class LinearProbing : public OpenAddressingBase<Tkey, Tdata, Tcapacity, Tequal, Tprobe, cacheHash>
     {
     private:
-        HashFunctions::FunctionModulus<Tkey> hashFunction;
-        
-        consts::t_uIndex hash(const Tkey &key)
+        using Base = OpenAddressingBase<Tkey, Tdata, Tcapacity, Tequal, Tprobe, cacheHash>;
+
+        bool incrementalRehash = false;
+
+        // The table being moved into this one by an incremental rehash, nullptr when there is none.
+        // Its elements are counted in the size of this table. Every key is in exactly one of the two.
+        LinearProbing *previous = nullptr;
+
+        // Slots of "previous" before this index are already moved, before "discarded" given back to the system.
+        consts::t_uIndex moved = 0;
+        consts::t_uIndex discarded = 0;
+
+        // Slots of "previous" moved per operation, paced by startMigration.
+        consts::t_uIndex step = consts::INCREMENTAL_REHASH_STEP;
+
+        // Slot array of the next incremental rehash while its control bytes are set, "prepared" of them
+        // so far; not allocated when none is pending.
+        typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash> next;
+        consts::t_uIndex prepared = 0;
+
+        // Lookups by a key of another type are enabled for transparent hash functions, see policy/Transparent.cc.
+        template <class Tother>
+        using enableLookup = policy::enableTransparent<Tkey, Tother, typename Tcapacity::t_hashFunction, Tequal>;
+
+        template <class Tk>
+        consts::t_uHash hash(const Tk &key)
         {
-            return this->hashFunction.hash(key);
+            return this->capacityPolicy.hash(key);
         }
 
-    public:
-        LinearProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : OpenAddressingBase<Tkey, Tdata>(capacity, loadFactorMin, loadFactorMax), hashFunction(HashFunctions::FunctionModulus<Tkey>(capacity)) {}
+        void migrate(consts::t_uIndex slots) noexcept(false)
+        {
+            for (; slots && this->moved < previous->capacity(); --slots, ++this->moved)
+            {
+                if (!previous->table.isOccupied(this->moved))
+                    continue;
+
+                this->place(previous->slotHash(this->moved), std::move(previous->table.getKey(this->moved)), std::move(previous->table.getData(this->moved)));
+                --this->_size;
+
+                // A tombstone keeps the probe sequences of the old array intact.
+                previous->table.erase(this->moved);
+            }
+
+            // The moved slots are given back a piece at a time, the free at the end unmaps little.
+            if (this->moved - this->discarded >= consts::INCREMENTAL_REHASH_RELEASE)
+            {
+                previous->table.discard(this->discarded, this->moved - this->discarded);
+                this->discarded = this->moved;
+            }
 
-        LinearProbing(const consts::t_uIndex &capacity) : OpenAddressingBase<Tkey, Tdata>(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX), hashFunction(HashFunctions::FunctionModulus<Tkey>(capacity)) {}
+            if (this->moved == previous->capacity())
+            {
+                // Only tombstones and empty slots are left, no destructor runs.
+                previous->table.release();
+                delete previous;
+                previous = nullptr;
+            }
+        }
 
-        LinearProbing() : OpenAddressingBase<Tkey, Tdata>(consts::DEFAULT_CAPACITY, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX), hashFunction(HashFunctions::FunctionModulus<Tkey>(consts::DEFAULT_CAPACITY)) {}
+        void migrateStep() noexcept(false)
+        {
+            if (previous)
+                this->migrate(this->step);
+        }
 
-        LinearProbing(const LinearProbing &other) : OpenAddressingBase<Tkey, Tdata>(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax()), hashFunction(other.hashFunction)
+        void migrateAll() noexcept(false)
         {
-            for (consts::t_uIndex i = 0; i < other.capacity(); ++i)
+            if (previous)
+                this->migrate(previous->capacity());
+        }
+
+        template <class Tk, class Td>
+        bool insertValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            consts::t_uHash hash = this->hash(key);
+
+            return this->insertValue(hash, std::forward<Tk>(key), std::forward<Td>(data));
+        }
+
+        // The full hash does not depend on the capacity, it stays valid over the reCapacity.
+        template <class Tk, class Td>
+        bool insertValue(const consts::t_uHash &hash, Tk &&key, Td &&data) noexcept(false)
+        {
+            // A new key needs a free slot: without the check a full table refused it.
+            if (!this->goodLoadFactor() || this->overloaded())
+                this->reCapacity();
+
+            this->migrateStep();
+
+            if (previous)
             {
-                auto key = other.table[i].getKey();
+                Tdata *found = previous->Base::search(hash, key);
 
-                if (key)
-                    this->insert(*key, *other.table[i].getData());
+                if (found)
+                {
+                    *found = std::forward<Td>(data);
+                    return true;
+                }
             }
+
+            return Base::insert(hash, std::forward<Tk>(key), std::forward<Td>(data));
         }
 
+        template <class Tk, class... Targs>
+        std::pair<Tdata *, bool> tryEmplaceKey(Tk &&key, Targs &&...args) noexcept(false)
+        {
+            if (!this->goodLoadFactor() || this->overloaded())
+                this->reCapacity();
+
+            consts::t_uHash hash = this->hash(key);
+
+            this->migrateStep();
+
+            if (previous)
+            {
+                Tdata *found = previous->Base::search(hash, key);
+
+                if (found)
+                    return {found, false};
+            }
+
+            std::pair<consts::t_uIndex, bool> result = Base::tryEmplace(hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
 
-        bool insert(const Tkey &key, const Tdata &data) noexcept override
+            if (result.first == this->capacity())
+                return {nullptr, false};
+
+            return {&this->table.getData(result.first), result.second};
+        }
+
+        template <class Tk, class... Targs>
+        bool emplaceKey(Tk &&key, Targs &&...args) noexcept(false)
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            if (!this->tryEmplaceKey(std::forward<Tk>(key), std::forward<Targs>(args)...).second)
+                return false;
 
-            return OpenAddressingBase<Tkey, Tdata>::insert(hashIndex, key, data);
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
         }
 
-        bool erase(const Tkey &key) noexcept override
+        template <class Tk>
+        bool eraseKey(const Tk &key) noexcept(false)
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            consts::t_uHash hash = this->hash(key);
 
-            return OpenAddressingBase<Tkey, Tdata>::erase(hashIndex, key);
+            this->migrateStep();
+
+            if (Base::erase(hash, key))
+                return true;
+
+            if (!previous || !previous->Base::erase(hash, key))
+                return false;
+
+            --this->_size;
+            return true;
         }
 
-        bool add(const Tkey &key, const Tdata &data) noexcept override
+        template <class Tk>
+        bool removeKey(const Tk &key) noexcept(false)
         {
+            if (!this->eraseKey(key))
+                return false;
+
             if (!this->goodLoadFactor())
                 this->reCapacity();
 
-            consts::t_uIndex hashIndex = this->hash(key);
+            return true;
+        }
+
+        template <class Tk>
+        Tdata *searchKey(const Tk &key) noexcept
+        {
+            return this->searchKey(this->hash(key), key);
+        }
+
+        template <class Tk>
+        Tdata *searchKey(const consts::t_uHash &hash, const Tk &key) noexcept
+        {
+            Tdata *result = Base::search(hash, key);
+
+            if (!result && previous)
+                result = previous->Base::search(hash, key);
+
+            return result;
+        }
+
+        // Hashes the keys and prefetches their home slots, count <= BATCH_SIZE.
+        void prefetchBatch(const Tkey *keys, const consts::t_uIndex &count, consts::t_uHash *hashes) noexcept
+        {
+            for (consts::t_uIndex i = 0; i < count; ++i)
+            {
+                hashes[i] = this->hash(keys[i]);
+                this->prefetch(hashes[i]);
+            }
+        }
+
+        void dropNext() noexcept
+        {
+            this->next.release();
+            this->prepared = 0;
+        }
+
+        // Sets the control bytes of the next slot array a piece per call and starts the move into it once
+        // they are all set. A pending array that no longer fits the size is dropped for a new one.
+        bool prepareMigration(const consts::t_uIndex &newCapacity) noexcept(false)
+        {
+            bool growing = newCapacity > this->capacity();
+
+            if (this->next.allocated() && ((this->next.capacity() > this->capacity()) != growing || this->next.capacity() < this->capacityFor(this->size())))
+                this->dropNext();
+
+            if (!this->next.allocated())
+                typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash>(newCapacity, false).swap(this->next);
+
+            consts::t_uIndex count = this->next.capacity() - this->prepared;
+
+            // A table about to run out of free slots sets the rest at once.
+            if (this->size() + 1 < this->capacity())
+                count = std::min<consts::t_uIndex>(count, consts::INCREMENTAL_REHASH_CLEAR / (sizeof(typename typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash>::Slot) + 1) + 1);
+
+            this->next.prepare(this->prepared, count);
+            this->prepared += count;
+
+            if (this->prepared < this->next.capacity())
+                return false;
+
+            this->startMigration();
+            return true;
+        }
+
+        // The current slots become the old array of an incremental rehash into the prepared ones.
+        void startMigration() noexcept(false)
+        {
+            typename Base::ReCapacityTimer timer(*this);
+
+            previous = new LinearProbing(0, this->getLoadFactorMin(), this->getLoadFactorMax(), this->capacityPolicy);
+
+            previous->table.swap(this->table);
+            previous->_capacity = this->_capacity;
+            previous->tombstones = this->tombstones;
+            this->tombstones = 0;
+            previous->capacityPolicy.resize(this->_capacity);
+            this->moved = 0;
+            this->discarded = 0;
+
+            this->next.swap(this->table);
+            this->prepared = 0;
+            this->_capacity = this->table.capacity();
+            this->capacityPolicy.resize(this->_capacity);
+
+            // Paced to be done while the new array has taken no more than half of the adds it has room for.
+            double room = this->getLoadFactorMax() * static_cast<double>(this->_capacity) - this->size();
+            consts::t_uIndex operations = static_cast<consts::t_uIndex>(std::max(room / 2, 1.0));
+
+            this->step = std::max(consts::INCREMENTAL_REHASH_STEP, previous->capacity() / operations + 1);
+        }
+
+        void rebuild(consts::t_uIndex newCapacity) noexcept(false)
+        {
+            typename Base::ReCapacityTimer timer(*this);
+            LinearProbing tmp(newCapacity, this->getLoadFactorMin(), this->getLoadFactorMax(), this->capacityPolicy);
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (this->table.isOccupied(i))
+                    tmp.place(this->slotHash(i), std::move(this->table.getKey(i)), std::move(this->table.getData(i)));
+            }
+
+            this->capacityPolicy.resize(newCapacity);
+            consts::swap(newCapacity, this->_capacity);
+            tmp.table.swap(this->table);
+            this->tombstones = 0;
+        }
+
+        // Adds the {key, data} pairs of the range; a range that can be measured in advance is reserved first.
+        template <class Titerator>
+        void addRange(Titerator first, Titerator last) noexcept(false)
+        {
+            if constexpr (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<Titerator>::iterator_category>::value)
+                this->reserve(this->size() + static_cast<consts::t_uIndex>(std::distance(first, last)));
+
+            for (; first != last; ++first)
+                this->add(first->first, first->second);
+        }
+
+    public:
+        LinearProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : Base(capacity, loadFactorMin, loadFactorMax) {}
+
+        LinearProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax, const Tcapacity &capacityPolicy) : Base(capacity, loadFactorMin, loadFactorMax, capacityPolicy) {}
+
+        LinearProbing(const consts::t_uIndex &capacity) : Base(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        LinearProbing() : Base(consts::DEFAULT_CAPACITY, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        // A table of the {key, data} pairs of a range, e.g. of a std::unordered_map, sized once for all
+        // of them. Of equal keys the first one is kept, as with add.
+        template <class Titerator, class = typename std::iterator_traits<Titerator>::iterator_category>
+        LinearProbing(Titerator first, Titerator last) : LinearProbing()
+        {
+            this->addRange(first, last);
+        }
+
+        LinearProbing(std::initializer_list<std::pair<Tkey, Tdata>> items) : LinearProbing(items.begin(), items.end()) {}
+
+        LinearProbing(const LinearProbing &other) : Base(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax(), other.capacityPolicy), incrementalRehash(other.incrementalRehash)
+        {
+            this->_reservedCapacity = other._reservedCapacity;
+            this->_growth = other._growth;
+
+            for (consts::t_uIndex i = 0; i < other.capacity(); ++i)
+            {
+                if (other.table.isOccupied(i))
+                    this->place(other.slotHash(i), other.table.getKey(i), other.table.getData(i));
+            }
+
+            if (!other.previous)
+                return;
+
+            for (consts::t_uIndex i = other.moved; i < other.previous->capacity(); ++i)
+            {
+                if (other.previous->table.isOccupied(i))
+                    this->place(other.previous->slotHash(i), other.previous->table.getKey(i), other.previous->table.getData(i));
+            }
+        }
+
+        bool getIncrementalRehash() const noexcept
+        {
+            return this->incrementalRehash;
+        }
+
+        bool setIncrementalRehash(bool incrementalRehash) noexcept(false)
+        {
+            if (!incrementalRehash)
+            {
+                this->migrateAll();
+                this->dropNext();
+            }
+
+            this->incrementalRehash = incrementalRehash;
+            return this->incrementalRehash;
+        }
+
+        // An incremental rehash is in progress: the old slot array is not empty yet.
+        bool rehashing() const noexcept
+        {
+            return previous;
+        }
+
+        // The elements of the old slot array of an incremental rehash come after the others.
+        typename Base::Iterator begin() noexcept
+        {
+            return typename Base::Iterator(&this->table, previous ? &previous->table : nullptr);
+        }
+
+        typename Base::ConstIterator begin() const noexcept
+        {
+            return typename Base::ConstIterator(&this->table, previous ? &previous->table : nullptr);
+        }
+
+        typename Base::Iterator end() noexcept
+        {
+            return typename Base::Iterator();
+        }
+
+        typename Base::ConstIterator end() const noexcept
+        {
+            return typename Base::ConstIterator();
+        }
+
+        void clear() noexcept
+        {
+            delete previous;
+            previous = nullptr;
+
+            this->dropNext();
+            Base::clear();
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->insertValue(key, data);
+        }
+
+        bool insert(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->insertValue(std::move(key), std::move(data));
+        }
+
+        bool erase(const Tkey &key) noexcept(false)
+        {
+            return this->eraseKey(key);
+        }
+
+        // erase by a key of another type, e.g. std::string_view for std::string keys.
+        template <class Tother, class = enableLookup<Tother>>
+        bool erase(const Tother &key) noexcept(false)
+        {
+            return this->eraseKey(key);
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->emplaceKey(key, data);
+        }
 
-            return OpenAddressingBase<Tkey, Tdata>::add(hashIndex, key, data);
+        bool add(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->emplaceKey(std::move(key), std::move(data));
         }
 
-        bool remove(const Tkey &key) noexcept override
+        // add() with the data constructed in place from the arguments.
+        template <class... Targs>
+        bool emplace(const Tkey &key, Targs &&...args) noexcept(false)
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            return this->emplaceKey(key, std::forward<Targs>(args)...);
+        }
+
+        template <class... Targs>
+        bool emplace(Tkey &&key, Targs &&...args) noexcept(false)
+        {
+            return this->emplaceKey(std::move(key), std::forward<Targs>(args)...);
+        }
+
+        // Data of the key and whether it was added now. The data is constructed from the arguments
+        // only if the key is absent, otherwise the arguments are left untouched. The pointer stays
+        // valid until the next change of the table: if the add overloads the table, it grows on the next add.
+        template <class... Targs>
+        std::pair<Tdata *, bool> tryEmplace(const Tkey &key, Targs &&...args) noexcept(false)
+        {
+            return this->tryEmplaceKey(key, std::forward<Targs>(args)...);
+        }
+
+        template <class... Targs>
+        std::pair<Tdata *, bool> tryEmplace(Tkey &&key, Targs &&...args) noexcept(false)
+        {
+            return this->tryEmplaceKey(std::move(key), std::forward<Targs>(args)...);
+        }
+
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
 
-            return OpenAddressingBase<Tkey, Tdata>::remove(hashIndex, key);
+        template <class Tother, class = enableLookup<Tother>>
+        bool remove(const Tother &key) noexcept(false)
+        {
+            return this->removeKey(key);
         }
 
         Tdata *search(const Tkey &key) noexcept
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            return this->searchKey(key);
+        }
+
+        // search by a key of another type, e.g. std::string_view for std::string keys: no Tkey is built.
+        template <class Tother, class = enableLookup<Tother>>
+        Tdata *search(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        bool containsKey(const Tkey &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool containsKey(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        // Batch operations hash the keys and prefetch their home slots BATCH_SIZE at a time before the
+        // probes run, so the cache misses of the keys overlap instead of following each other.
+        // results[i] - data of keys[i], nullptr if there is no such key.
+        void searchBatch(const Tkey *keys, const consts::t_uIndex &count, Tdata **results) noexcept
+        {
+            consts::t_uHash hashes[consts::BATCH_SIZE];
+
+            for (consts::t_uIndex first = 0; first < count; first += consts::BATCH_SIZE)
+            {
+                consts::t_uIndex size = std::min(count - first, consts::BATCH_SIZE);
+
+                this->prefetchBatch(keys + first, size, hashes);
+
+                for (consts::t_uIndex i = 0; i < size; ++i)
+                    results[first + i] = this->searchKey(hashes[i], keys[first + i]);
+            }
+        }
+
+        // results[i] - whether keys[i] is in the table. Returns the number of the keys found.
+        consts::t_uIndex containsBatch(const Tkey *keys, const consts::t_uIndex &count, bool *results) noexcept
+        {
+            consts::t_uHash hashes[consts::BATCH_SIZE];
+            consts::t_uIndex found = 0;
+
+            for (consts::t_uIndex first = 0; first < count; first += consts::BATCH_SIZE)
+            {
+                consts::t_uIndex size = std::min(count - first, consts::BATCH_SIZE);
+
+                this->prefetchBatch(keys + first, size, hashes);
+
+                for (consts::t_uIndex i = 0; i < size; ++i)
+                    found += results[first + i] = this->searchKey(hashes[i], keys[first + i]);
+            }
 
-            return OpenAddressingBase<Tkey, Tdata>::search(hashIndex, key);
+            return found;
         }
 
-        bool containsKey(const Tkey &key) noexcept override
+        // insert(keys[i], data[i]) for every i. Returns the number of the successful inserts.
+        consts::t_uIndex insertBatch(const Tkey *keys, const Tdata *data, const consts::t_uIndex &count) noexcept(false)
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            consts::t_uHash hashes[consts::BATCH_SIZE];
+            consts::t_uIndex inserted = 0;
 
-            return OpenAddressingBase<Tkey, Tdata>::search(hashIndex, key);
+            for (consts::t_uIndex first = 0; first < count; first += consts::BATCH_SIZE)
+            {
+                consts::t_uIndex size = std::min(count - first, consts::BATCH_SIZE);
+
+                this->prefetchBatch(keys + first, size, hashes);
+
+                for (consts::t_uIndex i = 0; i < size; ++i)
+                    inserted += this->insertValue(hashes[i], keys[first + i], data[first + i]);
+            }
+
+            return inserted;
         }
 
+        // Walks every slot, O(capacity). Bidirectional keeps a value index for frequent calls.
         bool contains(const Tdata &data) const 
         {
-            if(!this->table) return false;
+            if (previous && previous->contains(data))
+                return true;
+
+            if(!this->table.allocated()) return false;
             
-            for (consts::t_uIndex i = 0, j = 0; i < this->capacity(); ++i)
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
             {
-                auto ptr = this->table[i].getData();
-                if(ptr && *ptr == data) return true;
+                if(this->table.isOccupied(i) && this->table.getData(i) == data) return true;
             }
             return false;
         }
 
-        bool reCapacity() noexcept override
+        // Room for "count" elements: the capacity becomes at least count / loadFactorMax, so adding
+        // them makes no reCapacity on the way, see rehash.
+        void reserve(const consts::t_uIndex &count) noexcept(false)
+        {
+            this->rehash(this->capacityFor(count));
+        }
+
+        // Rebuilds the table once with at least "capacity" slots, and no fewer than the elements need
+        // at the maximum load factor. Removes do not shrink it below "capacity" after that, adds still
+        // grow it; rehash(0) shrinks it to fit and lifts the limit. O(size) at once in both rehash modes:
+        // a move in progress is finished first.
+        void rehash(const consts::t_uIndex &capacity) noexcept(false)
+        {
+            this->migrateAll();
+            this->dropNext();
+
+            consts::t_uIndex newCapacity = Tcapacity::round(std::max(capacity, this->capacityFor(this->size())));
+
+            this->_reservedCapacity = Tcapacity::round(capacity);
+
+            if (!newCapacity)
+                this->clear();
+            else if (newCapacity != this->capacity() || !this->table.allocated())
+                this->rebuild(newCapacity);
+        }
+
+        // The counters with the tombstones and the bytes of the slot arrays, the old one of an incremental rehash included.
+        Statistics statistics() const
+        {
+            Statistics result = Base::statistics();
+
+            if (!this->counting())
+                return result;
+
+            for (const LinearProbing *part = this; part; part = part->previous)
+            {
+                for (consts::t_uIndex i = 0; part->table.allocated() && i < part->capacity(); ++i)
+                    result.tombstones += part->table.isTombstone(i);
+
+                result.bytesAllocated += static_cast<unsigned long long>(part->capacity() + part->next.capacity()) * (sizeof(typename typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash>::Slot) + sizeof(typeNode::consts::t_control));
+            }
+
+            return result;
+        }
+
+        // Streaming binary form of the elements, see HashTable/Serialization.cc. save(buffer) appends
+        // to the buffer; load replaces the elements and reserves the header count before the first add.
+        void save(std::ostream &out) const noexcept(false)
+        {
+            serialization::Writer writer(out);
+
+            serialization::save(*this, writer);
+        }
+
+        void save(std::string &buffer) const noexcept(false)
+        {
+            serialization::Writer writer(buffer);
+
+            serialization::save(*this, writer);
+        }
+
+        void load(std::istream &in) noexcept(false)
+        {
+            serialization::Reader reader(in);
+
+            serialization::load(*this, reader);
+        }
+
+        void load(const char *data, const std::size_t &size) noexcept(false)
+        {
+            serialization::Reader reader(data, size);
+
+            serialization::load(*this, reader);
+        }
+
+        bool reCapacity() noexcept(false)
         {
             consts::t_uIndex newCapacity;
 
+            // One move at a time: a shrink waits for it, a growth that the pace of the move did not keep ahead of finishes it.
+            if (previous)
+            {
+                if (this->loadFactorStatus() != consts::LoadFactorStatus::GREATER_MAX)
+                    return false;
+
+                this->migrateAll();
+            }
+
             switch (this->loadFactorStatus())
             {
             case consts::LoadFactorStatus::ZERO_CAPACITY_AND_ZERO_SIZE:
 
-                this->table = new typeNode::OpenAddressing<Tkey, Tdata>[consts::DEFAULT_CAPACITY];
-                this->_capacity = consts::DEFAULT_CAPACITY;
-                this->hashFunction.resize(consts::DEFAULT_CAPACITY);
+                newCapacity = Tcapacity::round(consts::DEFAULT_CAPACITY);
+
+                typeNode::OpenAddressingFlat<Tkey, Tdata, cacheHash>(newCapacity).swap(this->table);
+                this->_capacity = newCapacity;
+                this->capacityPolicy.resize(newCapacity);
                 return true;
 
             case consts::LoadFactorStatus::GREATER_MAX:
-                newCapacity = this->size() / this->getLoadFactorMin();
+                newCapacity = Tcapacity::round(this->grownCapacity());
                 break;
 
             case consts::LoadFactorStatus::LESS_MIN:
-                newCapacity = this->size() / ((this->getLoadFactorMax() + this->getLoadFactorMin()) / 2);
+                newCapacity = Tcapacity::round(this->shrunkCapacity());
+
+                // The rounding left no smaller capacity within the load factors, see policy::Growth.
+                if (!this->shrinksTo(newCapacity))
+                    return false;
                 break;
 
             default:
-                return false;
-            }
-
-            HashTable::LinearProbing<Tkey, Tdata> tmp(newCapacity, this->getLoadFactorMin(), this->getLoadFactorMax());
-
-            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
-            {
-                auto key = this->table[i].getKey();
-
-                if (key)
-                    tmp.insert(*key, *this->table[i].getData());
+                if (!this->overloaded())
+                    return false;
+
+                // Tombstones pushed the table over the limit: rebuild it at the same capacity to drop them,
+                // or grow if the elements alone come close to the limit.
+                newCapacity = this->capacity();
+                if (4 * this->size() >= 3 * this->capacity() * this->getLoadFactorMax())
+                    newCapacity = Tcapacity::round(this->grownCapacity());
+                break;
             }
 
-            this->hashFunction.resize(newCapacity);
-            consts::swap(newCapacity, this->_capacity);
-            consts::swap(tmp.table, this->table);
+            if (this->incrementalRehash)
+                return this->prepareMigration(newCapacity);
 
+            this->rebuild(newCapacity);
             return true;
         }
 
-        virtual ~LinearProbing() {}
+        ~LinearProbing()
+        {
+            delete previous;
+            this->dropNext();
+        }
     };
 }
 
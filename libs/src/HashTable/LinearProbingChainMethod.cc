@@ -1,87 +1,367 @@
 #ifndef __HashTable_LinearProbingChainMethod_Class__
 #define __HashTable_LinearProbingChainMethod_Class__
 
-#include "HashFunctions/FunctionModulus.cc"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 #include "HashTable/ChainMethodBase.cc"
+#include "HashTable/Serialization.cc"
+#include "HashTable/policy/Capacity.cc"
+#include "HashTable/policy/KeyEqual.cc"
+#include "HashTable/policy/NodeAllocator.cc"
+#include "HashTable/policy/Transparent.cc"
 
 namespace HashTable
 {
 
-    template <class Tkey, class Tdata>
-    class LinearProbingChainMethod : public ChainMethodBase<Tkey, Tdata>
+    /**
+     * @tparam Tcapacity capacity policy from HashTable::policy: CapacityModulus (odd capacities, the default),
+     * CapacityPowerOfTwo (mask-based indexing) or CapacityFastModulus (prime capacities without divisions).
+     * The hash function is the one of the capacity policy.
+     * @tparam Tequal key equality, policy::KeyEqual compares keys with ==.
+     * @tparam cacheHash keep the full hash in every node: fewer key compares, reCapacity does not hash
+     * the keys again, at the cost of 8 bytes per node.
+     * @tparam Tallocator node allocator of the table from policy/NodeAllocator.cc: AllocatorNew (a new and
+     * a delete per node, the default) or AllocatorPool (nodes cut from large blocks and reused, clear() in
+     * O(blocks)).
+     * @tparam Tbucket typeNode::Chain (the default): a linked list of nodes per bucket, a node never moves
+     * until its key is erased. typeNode::UnrolledBucket: the first elements of a bucket are stored in
+     * the bucket itself, a cache line, the rest in overflow blocks of the same size. A lookup in a short
+     * bucket touches one cache line; the elements move on remove and reCapacity, so a Node pointer is
+     * valid only until the next change of the table.
+     *
+     * search/containsKey/erase/remove also take a key of another type when the hash function and Tequal
+     * are transparent, see policy/Transparent.cc.
+     *
+     * There is no incremental rehash here, unlike LinearProbing::setIncrementalRehash: reCapacity always
+     * moves every element in one operation, O(size + capacity). With Chain buckets it relinks the nodes
+     * and copies no elements, which makes the pause shorter than the one of an open addressing rebuild.
+     */
+    template <class Tkey, class Tdata, class Tcapacity = policy::CapacityModulus<Tkey>, class Tequal = policy::KeyEqual<Tkey>, bool cacheHash = false, template <class> class Tallocator = policy::AllocatorNew,
+              template <class, class, class, bool> class Tbucket = typeNode::Chain>
+    class LinearProbingChainMethod : public ChainMethodBase<Tkey, Tdata, Tequal, cacheHash, Tallocator, Tbucket>
     {
     private:
-        HashFunctions::FunctionModulus<Tkey> hashFunction;
-        
-        consts::t_uIndex hash(const Tkey &key)
+        using Base = ChainMethodBase<Tkey, Tdata, Tequal, cacheHash, Tallocator, Tbucket>;
+        using Node = typename Base::Node;
+
+        Tcapacity capacityPolicy;
+
+        // Lookups by a key of another type are enabled for transparent hash functions, see policy/Transparent.cc.
+        template <class Tother>
+        using enableLookup = policy::enableTransparent<Tkey, Tother, typename Tcapacity::t_hashFunction, Tequal>;
+
+        template <class Tk>
+        consts::t_uHash hash(const Tk &key)
+        {
+            return this->capacityPolicy.hash(key);
+        }
+
+        // A table without buckets gets an index out of range, the base functions reject it.
+        consts::t_uIndex index(const consts::t_uHash &hash)
+        {
+            return this->capacity() ? this->capacityPolicy.indexOf(hash) : this->capacity();
+        }
+
+        consts::t_uHash nodeHash(const Node &node)
         {
-            return this->hashFunction.hash(key);
+            if constexpr (cacheHash)
+                return node.hash;
+            else
+                return this->capacityPolicy.hash(node.key);
+        }
+
+        template <class Tk, class Td>
+        bool insertValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            // Like add: after clear() the table has no buckets, without the check insert was refused.
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            consts::t_uHash hash = this->hash(key);
+
+            return Base::insert(this->index(hash), hash, std::forward<Tk>(key), std::forward<Td>(data));
+        }
+
+        // Room for "count" more elements within loadFactorMax, grown at least geometrically as add grows:
+        // a batch gets its bucket indexes after it, no reCapacity happens in the middle of the batch.
+        void growFor(const consts::t_uIndex &count) noexcept(false)
+        {
+            consts::t_uIndex needed = this->capacityFor(this->size() + count);
+
+            if (this->table && needed <= this->capacity())
+                return;
+
+            consts::t_uIndex newCapacity = Tcapacity::round(std::max({needed, this->grownCapacity(), consts::DEFAULT_CAPACITY}));
+
+            this->capacityPolicy.resize(newCapacity);
+            this->rebuild(newCapacity, [this](const Node &node) { return this->capacityPolicy.indexOf(this->nodeHash(node)); });
+        }
+
+        // Hashes the keys, prefetches their buckets and then the first nodes of the chains, count <= BATCH_SIZE.
+        void prefetchBatch(const Tkey *keys, const consts::t_uIndex &count, consts::t_uHash *hashes, consts::t_uIndex *indexes) noexcept
+        {
+            for (consts::t_uIndex i = 0; i < count; ++i)
+            {
+                hashes[i] = this->hash(keys[i]);
+                indexes[i] = this->index(hashes[i]);
+                this->prefetchBucket(indexes[i]);
+            }
+
+            for (consts::t_uIndex i = 0; i < count; ++i)
+                this->prefetchChain(indexes[i]);
+        }
+
+        template <class Tk, class... Targs>
+        std::pair<Node *, bool> tryEmplaceKey(Tk &&key, Targs &&...args) noexcept(false)
+        {
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            consts::t_uHash hash = this->hash(key);
+
+            return Base::tryEmplace(this->index(hash), hash, std::forward<Tk>(key), std::forward<Targs>(args)...);
+        }
+
+        template <class Tk>
+        bool eraseKey(const Tk &key) noexcept
+        {
+            consts::t_uHash hash = this->hash(key);
+
+            return Base::erase(this->index(hash), hash, key);
+        }
+
+        template <class Tk>
+        bool removeKey(const Tk &key) noexcept(false)
+        {
+            if (!this->eraseKey(key))
+                return false;
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk>
+        Node *searchKey(const Tk &key) noexcept
+        {
+            consts::t_uHash hash = this->hash(key);
+
+            return Base::search(this->index(hash), hash, key);
+        }
+
+        // Adds the {key, data} pairs of the range; a range that can be measured in advance is reserved first.
+        template <class Titerator>
+        void addRange(Titerator first, Titerator last) noexcept(false)
+        {
+            if constexpr (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<Titerator>::iterator_category>::value)
+                this->reserve(this->size() + static_cast<consts::t_uIndex>(std::distance(first, last)));
+
+            for (; first != last; ++first)
+                this->add(first->first, first->second);
         }
 
     public:
-        LinearProbingChainMethod(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : ChainMethodBase<Tkey, Tdata>(capacity, loadFactorMin, loadFactorMax), hashFunction(HashFunctions::FunctionModulus<Tkey>(capacity)) {}
+        LinearProbingChainMethod(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : Base(Tcapacity::round(capacity), loadFactorMin, loadFactorMax), capacityPolicy(Tcapacity::round(capacity)) {}
+
+        LinearProbingChainMethod(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax, const Tcapacity &capacityPolicy) : Base(Tcapacity::round(capacity), loadFactorMin, loadFactorMax), capacityPolicy(capacityPolicy)
+        {
+            this->capacityPolicy.resize(this->capacity());
+        }
+
+        LinearProbingChainMethod(const consts::t_uIndex &capacity) : LinearProbingChainMethod(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
 
-        LinearProbingChainMethod(const consts::t_uIndex &capacity) : ChainMethodBase<Tkey, Tdata>(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX), hashFunction(HashFunctions::FunctionModulus<Tkey>(capacity)) {}
+        LinearProbingChainMethod() : LinearProbingChainMethod(consts::DEFAULT_CAPACITY, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        // A table of the {key, data} pairs of a range, e.g. of a std::unordered_map, sized once for all
+        // of them. Of equal keys the first one is kept, as with add.
+        template <class Titerator, class = typename std::iterator_traits<Titerator>::iterator_category>
+        LinearProbingChainMethod(Titerator first, Titerator last) : LinearProbingChainMethod()
+        {
+            this->addRange(first, last);
+        }
 
-        LinearProbingChainMethod() : ChainMethodBase<Tkey, Tdata>(consts::DEFAULT_CAPACITY, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX), hashFunction(HashFunctions::FunctionModulus<Tkey>(consts::DEFAULT_CAPACITY)) {}
+        LinearProbingChainMethod(std::initializer_list<std::pair<Tkey, Tdata>> items) : LinearProbingChainMethod(items.begin(), items.end()) {}
 
-        LinearProbingChainMethod(const LinearProbingChainMethod &other) : ChainMethodBase<Tkey, Tdata>(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax()), hashFunction(other.hashFunction)
+        LinearProbingChainMethod(const LinearProbingChainMethod &other) : LinearProbingChainMethod(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax(), other.capacityPolicy)
         {
+            this->_reservedCapacity = other._reservedCapacity;
+            this->_growth = other._growth;
+
             for (consts::t_uIndex i = 0; i < other.capacity(); ++i)
             {
                 for (auto& item : other.table[i])
                 {
-                    this->insert(item.key, item.data);
+                    consts::t_uHash hash = this->nodeHash(item);
+                    this->place(this->index(hash), hash, item.key, item.data);
                 }
             }
         }
 
-        bool insert(const Tkey &key, const Tdata &data) noexcept override
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            return this->insertValue(key, data);
+        }
 
-            return ChainMethodBase<Tkey, Tdata>::insert(hashIndex, key, data);
+        bool insert(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->insertValue(std::move(key), std::move(data));
         }
 
-        bool erase(const Tkey &key) noexcept override
+        bool erase(const Tkey &key) noexcept
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            return this->eraseKey(key);
+        }
 
-            return ChainMethodBase<Tkey, Tdata>::erase(hashIndex, key);
+        // erase by a key of another type, e.g. std::string_view for std::string keys.
+        template <class Tother, class = enableLookup<Tother>>
+        bool erase(const Tother &key) noexcept
+        {
+            return this->eraseKey(key);
         }
 
-        bool add(const Tkey &key, const Tdata &data) noexcept override
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
         {
-            if (!this->goodLoadFactor())
-                this->reCapacity();
+            return this->tryEmplaceKey(key, data).second;
+        }
+
+        bool add(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->tryEmplaceKey(std::move(key), std::move(data)).second;
+        }
+
+        // add() with the data constructed in place from the arguments.
+        template <class... Targs>
+        bool emplace(const Tkey &key, Targs &&...args) noexcept(false)
+        {
+            return this->tryEmplaceKey(key, std::forward<Targs>(args)...).second;
+        }
+
+        template <class... Targs>
+        bool emplace(Tkey &&key, Targs &&...args) noexcept(false)
+        {
+            return this->tryEmplaceKey(std::move(key), std::forward<Targs>(args)...).second;
+        }
+
+        // Node of the key and whether it was added now. The data is constructed from the arguments
+        // only if the key is absent, otherwise the arguments are left untouched. With Chain buckets
+        // nodes are never moved, the pointer stays valid until the key is erased, see Tbucket.
+        template <class... Targs>
+        std::pair<Node *, bool> tryEmplace(const Tkey &key, Targs &&...args) noexcept(false)
+        {
+            return this->tryEmplaceKey(key, std::forward<Targs>(args)...);
+        }
+
+        template <class... Targs>
+        std::pair<Node *, bool> tryEmplace(Tkey &&key, Targs &&...args) noexcept(false)
+        {
+            return this->tryEmplaceKey(std::move(key), std::forward<Targs>(args)...);
+        }
 
-            consts::t_uIndex hashIndex = this->hash(key);
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
 
-            return ChainMethodBase<Tkey, Tdata>::add(hashIndex, key, data);
+        template <class Tother, class = enableLookup<Tother>>
+        bool remove(const Tother &key) noexcept(false)
+        {
+            return this->removeKey(key);
         }
 
-        bool remove(const Tkey &key) noexcept override
+        Node* search(const Tkey &key) noexcept
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            return this->searchKey(key);
+        }
 
-            return ChainMethodBase<Tkey, Tdata>::remove(hashIndex, key);
+        // search by a key of another type, e.g. std::string_view for std::string keys: no Tkey is built.
+        template <class Tother, class = enableLookup<Tother>>
+        Node* search(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
         }
 
-        typename typeNode::Chain<Tkey, Tdata>::Node* search(const Tkey &key) noexcept
+        bool containsKey(const Tkey &key) noexcept
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            return this->searchKey(key);
+        }
 
-            return ChainMethodBase<Tkey, Tdata>::search(hashIndex, key);
+        template <class Tother, class = enableLookup<Tother>>
+        bool containsKey(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
         }
 
-        bool containsKey(const Tkey &key) noexcept override
+        // Batch operations hash the keys and prefetch their buckets and chain heads BATCH_SIZE at a time
+        // before the chains are walked, so the cache misses of the keys overlap instead of following each other.
+        // results[i] - node of keys[i], nullptr if there is no such key.
+        void searchBatch(const Tkey *keys, const consts::t_uIndex &count, Node **results) noexcept
         {
-            consts::t_uIndex hashIndex = this->hash(key);
+            consts::t_uHash hashes[consts::BATCH_SIZE];
+            consts::t_uIndex indexes[consts::BATCH_SIZE];
+
+            for (consts::t_uIndex first = 0; first < count; first += consts::BATCH_SIZE)
+            {
+                consts::t_uIndex size = std::min(count - first, consts::BATCH_SIZE);
+
+                this->prefetchBatch(keys + first, size, hashes, indexes);
+
+                for (consts::t_uIndex i = 0; i < size; ++i)
+                    results[first + i] = Base::search(indexes[i], hashes[i], keys[first + i]);
+            }
+        }
+
+        // results[i] - whether keys[i] is in the table. Returns the number of the keys found.
+        consts::t_uIndex containsBatch(const Tkey *keys, const consts::t_uIndex &count, bool *results) noexcept
+        {
+            consts::t_uHash hashes[consts::BATCH_SIZE];
+            consts::t_uIndex indexes[consts::BATCH_SIZE];
+            consts::t_uIndex found = 0;
+
+            for (consts::t_uIndex first = 0; first < count; first += consts::BATCH_SIZE)
+            {
+                consts::t_uIndex size = std::min(count - first, consts::BATCH_SIZE);
+
+                this->prefetchBatch(keys + first, size, hashes, indexes);
+
+                for (consts::t_uIndex i = 0; i < size; ++i)
+                    found += results[first + i] = Base::search(indexes[i], hashes[i], keys[first + i]);
+            }
+
+            return found;
+        }
+
+        // insert(keys[i], data[i]) for every i, the table grows as with insert. Returns the number of the successful inserts.
+        consts::t_uIndex insertBatch(const Tkey *keys, const Tdata *data, const consts::t_uIndex &count) noexcept(false)
+        {
+            consts::t_uHash hashes[consts::BATCH_SIZE];
+            consts::t_uIndex indexes[consts::BATCH_SIZE];
+            consts::t_uIndex inserted = 0;
+
+            for (consts::t_uIndex first = 0; first < count; first += consts::BATCH_SIZE)
+            {
+                consts::t_uIndex size = std::min(count - first, consts::BATCH_SIZE);
+
+                this->growFor(size);
+                this->prefetchBatch(keys + first, size, hashes, indexes);
+
+                for (consts::t_uIndex i = 0; i < size; ++i)
+                    inserted += Base::insert(indexes[i], hashes[i], keys[first + i], data[first + i]);
+            }
 
-            return ChainMethodBase<Tkey, Tdata>::search(hashIndex, key);
+            return inserted;
         }
 
-        bool contains(const Tdata &data) const override
+        // Walks every bucket, O(capacity). Bidirectional keeps a value index for frequent calls.
+        bool contains(const Tdata &data) const
         {
             if(!this->table) return false;
             
@@ -96,7 +376,66 @@ namespace HashTable
             return false;
         }
 
-        bool reCapacity() noexcept override
+        // Room for "count" elements: at least count / loadFactorMax buckets, so adding them makes no
+        // reCapacity on the way, see rehash.
+        void reserve(const consts::t_uIndex &count) noexcept(false)
+        {
+            this->rehash(this->capacityFor(count));
+        }
+
+        // Moves the elements once to at least "capacity" buckets, and no fewer than they need at the
+        // maximum load factor. Removes do not shrink the table below "capacity" after that, adds still
+        // grow it; rehash(0) shrinks it to fit and lifts the limit.
+        void rehash(const consts::t_uIndex &capacity) noexcept(false)
+        {
+            consts::t_uIndex newCapacity = Tcapacity::round(std::max(capacity, this->capacityFor(this->size())));
+
+            this->_reservedCapacity = Tcapacity::round(capacity);
+
+            if (!newCapacity)
+            {
+                this->clear();
+                return;
+            }
+
+            if (newCapacity == this->capacity() && this->table)
+                return;
+
+            this->capacityPolicy.resize(newCapacity);
+            this->rebuild(newCapacity, [this](const Node &node) { return this->capacityPolicy.indexOf(this->nodeHash(node)); });
+        }
+
+        // Streaming binary form of the elements, see HashTable/Serialization.cc. save(buffer) appends
+        // to the buffer; load replaces the elements and reserves the header count before the first add.
+        void save(std::ostream &out) const noexcept(false)
+        {
+            serialization::Writer writer(out);
+
+            serialization::save(*this, writer);
+        }
+
+        void save(std::string &buffer) const noexcept(false)
+        {
+            serialization::Writer writer(buffer);
+
+            serialization::save(*this, writer);
+        }
+
+        void load(std::istream &in) noexcept(false)
+        {
+            serialization::Reader reader(in);
+
+            serialization::load(*this, reader);
+        }
+
+        void load(const char *data, const std::size_t &size) noexcept(false)
+        {
+            serialization::Reader reader(data, size);
+
+            serialization::load(*this, reader);
+        }
+
+        bool reCapacity() noexcept(false)
         {
             consts::t_uIndex newCapacity;
 
@@ -104,41 +443,37 @@ namespace HashTable
             {
             case consts::LoadFactorStatus::ZERO_CAPACITY_AND_ZERO_SIZE:
 
-                this->table = new typeNode::Chain<Tkey, Tdata>[consts::DEFAULT_CAPACITY];
-                this->_capacity = consts::DEFAULT_CAPACITY;
-                this->hashFunction.resize(consts::DEFAULT_CAPACITY);
+                newCapacity = Tcapacity::round(consts::DEFAULT_CAPACITY);
+
+                this->table = new typename Base::Bucket[newCapacity];
+                this->_capacity = newCapacity;
+                this->capacityPolicy.resize(newCapacity);
                 return true;
 
             case consts::LoadFactorStatus::GREATER_MAX:
-                newCapacity = this->size() / this->getLoadFactorMin();
+                newCapacity = Tcapacity::round(this->grownCapacity());
                 break;
 
             case consts::LoadFactorStatus::LESS_MIN:
-                newCapacity = this->size() / ((this->getLoadFactorMax() + this->getLoadFactorMin()) / 2);
+                newCapacity = Tcapacity::round(this->shrunkCapacity());
+
+                // The rounding left no smaller capacity within the load factors, see policy::Growth.
+                if (!this->shrinksTo(newCapacity))
+                    return false;
                 break;
 
             default:
                 return false;
             }
 
-            HashTable::LinearProbingChainMethod<Tkey, Tdata> tmp(newCapacity, this->getLoadFactorMin(), this->getLoadFactorMax());
-
-            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
-            {
-                for (auto& item : this->table[i])
-                {
-                    tmp.insert(item.key, item.data);
-                }
-            }
-
-            this->hashFunction.resize(newCapacity);
-            consts::swap(newCapacity, this->_capacity);
-            consts::swap(tmp.table, this->table);
+            // The full hash does not depend on the capacity: nodeHash works before and after the resize.
+            this->capacityPolicy.resize(newCapacity);
+            this->rebuild(newCapacity, [this](const Node &node) { return this->capacityPolicy.indexOf(this->nodeHash(node)); });
 
             return true;
         }
 
-        virtual ~LinearProbingChainMethod() {}
+        ~LinearProbingChainMethod() {}
     };
 }
 
@@ -0,0 +1,446 @@
+#ifndef __HashTable_RobinHoodProbing_Class__
+#define __HashTable_RobinHoodProbing_Class__
+
+#include <string>
+#include <utility>
+
+#include "HashFunctions/FunctionFibonacci.cc"
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/KeyEqual.cc"
+#include "HashTable/policy/Transparent.cc"
+#include "HashTable/typeNode/OpenAddressingFlat.cc"
+#include "HashTable/typeNode/SlotIterator.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        // The probe sequence length is kept in the control byte of the slot.
+        const typeNode::consts::t_control ROBIN_HOOD_MAX_PROBE_LENGTH = 0x7F;
+    }
+
+    // Probe sequence lengths of the elements of a RobinHoodProbing, see RobinHoodProbing::probeStatistics.
+    struct RobinHoodProbeStatistics
+    {
+        consts::t_stat mean;
+        consts::t_stat variance;
+        consts::t_uIndex max;
+    };
+
+    /**
+     * Linear probing with Robin Hood displacement: an element that is further from its home slot
+     * takes the place of a closer one. Every slot keeps its probe sequence length (PSL), so a miss
+     * stops as soon as it meets a slot with a smaller PSL, and erase shifts the following elements
+     * back instead of leaving a tombstone.
+     */
+    template <class Tkey, class Tdata, class Thash = HashFunctions::FunctionFibonacci<Tkey>, class Tequal = policy::KeyEqual<Tkey>>
+    class RobinHoodProbing : public HashTableBase<Tkey, Tdata>
+    {
+    private:
+        Thash hashFunction;
+        Tequal keyEqual;
+        typeNode::OpenAddressingFlat<Tkey, Tdata> table;
+
+        // Lookups by a key of another type are enabled for a transparent Thash, see policy/Transparent.cc.
+        template <class Tother>
+        using enableLookup = policy::enableTransparent<Tkey, Tother, Thash, Tequal>;
+
+        // High 32 bits of the hash scaled to [0, capacity) by a multiply and a shift, without a division.
+        template <class Tk>
+        consts::t_uIndex hash(const Tk &key) const
+        {
+            return static_cast<consts::t_uIndex>(((this->hashFunction.hash(key) >> 32) * this->capacity()) >> 32);
+        }
+
+        consts::t_uIndex next(const consts::t_uIndex &index) const noexcept
+        {
+            return index + 1 == this->capacity() ? 0 : index + 1;
+        }
+
+        template <class Tk>
+        consts::t_uIndex find(const Tk &key) const noexcept
+        {
+            if (!table.allocated())
+                return this->capacity();
+
+            consts::t_uIndex index = this->hash(key);
+            typeNode::consts::t_control distance = 0;
+
+            while (table.isOccupied(index) && table.getControl(index) >= distance)
+            {
+                if (this->keyEqual(table.getKey(index), key))
+                    return index;
+
+                index = this->next(index);
+                ++distance;
+            }
+
+            return this->capacity();
+        }
+
+        // The key must be absent. Grows the table if it is full or a probe sequence gets too long.
+        void place(Tkey key, Tdata data) noexcept(false)
+        {
+            if (this->size() == this->capacity())
+                this->grow();
+
+            consts::t_uIndex index = this->hash(key);
+            typeNode::consts::t_control distance = 0;
+
+            while (table.isOccupied(index))
+            {
+                if (table.getControl(index) < distance)
+                {
+                    typeNode::consts::t_control tmp = table.getControl(index);
+                    table.setControl(index, distance);
+                    distance = tmp;
+
+                    std::swap(key, table.getKey(index));
+                    std::swap(data, table.getData(index));
+                }
+
+                index = this->next(index);
+
+                if (++distance > consts::ROBIN_HOOD_MAX_PROBE_LENGTH)
+                {
+                    this->grow();
+                    this->place(std::move(key), std::move(data));
+                    return;
+                }
+            }
+
+            table.set(index, std::move(key), std::move(data), distance);
+            ++this->_size;
+        }
+
+        void unset(consts::t_uIndex index) noexcept
+        {
+            table.erase(index, typeNode::consts::CONTROL_EMPTY);
+            --this->_size;
+
+            for (consts::t_uIndex following = this->next(index); table.isOccupied(following) && table.getControl(following); following = this->next(following))
+            {
+                table.relocate(index, following, table.getControl(following) - 1);
+                index = following;
+            }
+        }
+
+        template <class Tk, class Td>
+        bool insertValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            consts::t_uIndex index = this->find(key);
+
+            if (index != this->capacity())
+            {
+                table.setData(index, std::forward<Td>(data));
+                return true;
+            }
+
+            this->place(std::forward<Tk>(key), std::forward<Td>(data));
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk, class Td>
+        bool addValue(Tk &&key, Td &&data) noexcept(false)
+        {
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            if (this->find(key) != this->capacity())
+                return false;
+
+            this->place(std::forward<Tk>(key), std::forward<Td>(data));
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk>
+        bool eraseKey(const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(key);
+
+            if (index == this->capacity())
+                return false;
+
+            this->unset(index);
+            return true;
+        }
+
+        template <class Tk>
+        bool removeKey(const Tk &key) noexcept(false)
+        {
+            if (!this->eraseKey(key))
+                return false;
+
+            if (!this->goodLoadFactor())
+                this->reCapacity();
+
+            return true;
+        }
+
+        template <class Tk>
+        Tdata *searchKey(const Tk &key) noexcept
+        {
+            consts::t_uIndex index = this->find(key);
+
+            if (index == this->capacity())
+                return nullptr;
+
+            return &table.getData(index);
+        }
+
+        // The elements are copied into the new table when their move may throw: if it does, this table still has them all.
+        void rebuild(const consts::t_uIndex &newCapacity) noexcept(false)
+        {
+            RobinHoodProbing tmp(newCapacity, this->getLoadFactorMin(), this->getLoadFactorMax());
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (table.isOccupied(i))
+                    tmp.place(std::move_if_noexcept(table.getKey(i)), std::move_if_noexcept(table.getData(i)));
+            }
+
+            this->_capacity = tmp.capacity();
+            tmp.table.swap(this->table);
+        }
+
+        void grow() noexcept(false)
+        {
+            this->rebuild(this->capacity() < consts::DEFAULT_CAPACITY ? consts::DEFAULT_CAPACITY : 2 * this->capacity());
+        }
+
+    public:
+        RobinHoodProbing(const consts::t_uIndex &capacity, const consts::t_stat loadFactorMin, const consts::t_stat loadFactorMax) : HashTableBase<Tkey, Tdata>(capacity, loadFactorMin, loadFactorMax), table(capacity) {}
+
+        RobinHoodProbing(const consts::t_uIndex &capacity) : RobinHoodProbing(capacity, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        RobinHoodProbing() : RobinHoodProbing(consts::DEFAULT_CAPACITY, consts::DEFAULT_LOAD_FACTOR_MIN, consts::DEFAULT_LOAD_FACTOR_MAX) {}
+
+        RobinHoodProbing(const RobinHoodProbing &other) : RobinHoodProbing(other.capacity(), other.getLoadFactorMin(), other.getLoadFactorMax())
+        {
+            this->_growth = other._growth;
+
+            for (consts::t_uIndex i = 0; i < other.capacity(); ++i)
+            {
+                if (other.table.isOccupied(i))
+                    this->insert(other.table.getKey(i), other.table.getData(i));
+            }
+        }
+
+        void clear() noexcept
+        {
+            table.clear();
+            this->_capacity = 0;
+            this->_size = 0;
+        }
+
+        bool insert(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->insertValue(key, data);
+        }
+
+        bool insert(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->insertValue(std::move(key), std::move(data));
+        }
+
+        bool erase(const Tkey &key) noexcept
+        {
+            return this->eraseKey(key);
+        }
+
+        // erase by a key of another type, e.g. std::string_view for std::string keys.
+        template <class Tother, class = enableLookup<Tother>>
+        bool erase(const Tother &key) noexcept
+        {
+            return this->eraseKey(key);
+        }
+
+        bool add(const Tkey &key, const Tdata &data) noexcept(false)
+        {
+            return this->addValue(key, data);
+        }
+
+        bool add(Tkey &&key, Tdata &&data) noexcept(false)
+        {
+            return this->addValue(std::move(key), std::move(data));
+        }
+
+        bool remove(const Tkey &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool remove(const Tother &key) noexcept(false)
+        {
+            return this->removeKey(key);
+        }
+
+        Tdata *search(const Tkey &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        // search by a key of another type, e.g. std::string_view for std::string keys: no Tkey is built.
+        template <class Tother, class = enableLookup<Tother>>
+        Tdata *search(const Tother &key) noexcept
+        {
+            return this->searchKey(key);
+        }
+
+        bool containsKey(const Tkey &key) noexcept
+        {
+            return this->find(key) != this->capacity();
+        }
+
+        template <class Tother, class = enableLookup<Tother>>
+        bool containsKey(const Tother &key) noexcept
+        {
+            return this->find(key) != this->capacity();
+        }
+
+        bool contains(const Tdata &data) const
+        {
+            if (!table.allocated())
+                return false;
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (table.isOccupied(i) && table.getData(i) == data)
+                    return true;
+            }
+            return false;
+        }
+
+        RobinHoodProbeStatistics probeStatistics() const noexcept
+        {
+            RobinHoodProbeStatistics result = {0, 0, 0};
+
+            if (!this->size())
+                return result;
+
+            consts::t_stat sum = 0, sumSquares = 0;
+
+            for (consts::t_uIndex i = 0; i < this->capacity(); ++i)
+            {
+                if (!table.isOccupied(i))
+                    continue;
+
+                consts::t_uIndex length = table.getControl(i);
+
+                sum += length;
+                sumSquares += static_cast<consts::t_stat>(length) * length;
+
+                if (length > result.max)
+                    result.max = length;
+            }
+
+            result.mean = sum / this->size();
+            result.variance = sumSquares / this->size() - result.mean * result.mean;
+
+            return result;
+        }
+
+        // Forward iterators over the elements, each is a Slot with key and data, see typeNode::SlotIterator.
+        using Iterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata>, false>;
+        using ConstIterator = typeNode::SlotIterator<typeNode::OpenAddressingFlat<Tkey, Tdata>, true>;
+
+        Iterator begin() noexcept
+        {
+            return Iterator(&table, nullptr);
+        }
+
+        ConstIterator begin() const noexcept
+        {
+            return ConstIterator(&table, nullptr);
+        }
+
+        Iterator end() noexcept
+        {
+            return Iterator();
+        }
+
+        ConstIterator end() const noexcept
+        {
+            return ConstIterator();
+        }
+
+        bool reCapacity() noexcept(false)
+        {
+            consts::t_uIndex newCapacity;
+
+            switch (this->loadFactorStatus())
+            {
+            case consts::LoadFactorStatus::ZERO_CAPACITY_AND_ZERO_SIZE:
+
+                typeNode::OpenAddressingFlat<Tkey, Tdata>(consts::DEFAULT_CAPACITY).swap(this->table);
+                this->_capacity = consts::DEFAULT_CAPACITY;
+                return true;
+
+            case consts::LoadFactorStatus::GREATER_MAX:
+                newCapacity = this->grownCapacity();
+                break;
+
+            case consts::LoadFactorStatus::LESS_MIN:
+                newCapacity = this->shrunkCapacity();
+
+                if (!this->shrinksTo(newCapacity))
+                    return false;
+                break;
+
+            default:
+                return false;
+            }
+
+            this->rebuild(newCapacity);
+
+            return true;
+        }
+
+        std::string toString() const
+        {
+            std::string result;
+
+            result += "RobinHoodTable: {\n";
+
+            if (table.allocated())
+            {
+                for (consts::t_uIndex i = 0, j = 0; i < this->capacity(); ++i)
+                {
+                    if (table.isOccupied(i))
+                    {
+                        result += "\t" + tools::toString(table.getKey(i));
+
+                        result += " : ";
+
+                        result += tools::toString(table.getData(i));
+
+                        if (j < this->size() - 1)
+                        {
+                            result += ",\n";
+                            ++j;
+                        }
+                    }
+                }
+            }
+
+            result += "\n};";
+            return result;
+        }
+
+        ~RobinHoodProbing() {}
+    };
+}
+
+#endif
@@ -0,0 +1,434 @@
+#ifndef __HashTable_Snapshot_Class__
+#define __HashTable_Snapshot_Class__
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "HashFunctions/FunctionFibonacci.cc"
+#include "HashTable/HashTableBase.cc"
+#include "HashTable/policy/Capacity.cc"
+#include "HashTable/typeNode/OpenAddressingFlat.cc"
+
+namespace HashTable
+{
+    namespace consts
+    {
+        // "HTSNAP" and the byte order mark 0x0102: a file of a machine with another byte order is refused.
+        const std::uint64_t SNAPSHOT_MAGIC = 0x48'54'53'4E'41'50'01'02ull;
+        const std::uint32_t SNAPSHOT_VERSION = 2;
+
+        const t_stat SNAPSHOT_LOAD_FACTOR = 0.7;
+
+        // Every section of the file starts on a cache line.
+        const std::uint64_t SNAPSHOT_ALIGNMENT = 64;
+    }
+
+    namespace typeNode
+    {
+        // A std::string of a snapshot: its bytes in the string arena of the file.
+        struct StringRef
+        {
+            std::uint64_t offset;
+            std::uint64_t length;
+        };
+
+        /**
+         * How a key or data type lies in a snapshot: trivially copyable types as they are,
+         * std::string as a StringRef. Other types are refused at compile time.
+         */
+        template <class T>
+        struct Stored
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "a snapshot keeps trivially copyable types and std::string only");
+
+            using t_stored = T;
+
+            // Whether the stored values point into the arena: their references are checked when a file is opened.
+            static constexpr bool REFERENCES = false;
+
+            static std::uint64_t arenaSize(const T &) noexcept
+            {
+                return 0;
+            }
+
+            static bool valid(const t_stored &, const std::uint64_t &) noexcept
+            {
+                return true;
+            }
+
+            static t_stored store(const T &value, char *, std::uint64_t &) noexcept
+            {
+                return value;
+            }
+
+            template <class Tother>
+            static bool equal(const t_stored &stored, const char *, const Tother &value)
+            {
+                return stored == value;
+            }
+        };
+
+        template <>
+        struct Stored<std::string>
+        {
+            using t_stored = StringRef;
+
+            static constexpr bool REFERENCES = true;
+
+            static std::uint64_t arenaSize(const std::string &value) noexcept
+            {
+                return value.size();
+            }
+
+            // The bytes lie within an arena of "arenaSize" bytes.
+            static bool valid(const t_stored &stored, const std::uint64_t &arenaSize) noexcept
+            {
+                return stored.length <= arenaSize && stored.offset <= arenaSize - stored.length;
+            }
+
+            // Copies the bytes to the arena at "used" and moves "used" past them.
+            static t_stored store(const std::string &value, char *arena, std::uint64_t &used) noexcept
+            {
+                StringRef result{used, value.size()};
+
+                std::memcpy(arena + used, value.data(), value.size());
+                used += value.size();
+
+                return result;
+            }
+
+            template <class Tother>
+            static bool equal(const t_stored &stored, const char *arena, const Tother &value)
+            {
+                return std::string_view(arena + stored.offset, stored.length) == value;
+            }
+        };
+    }
+
+    /**
+     * Read-only table in a memory-mapped file. write() lays a table out once as the file: a header,
+     * the control bytes, the slots of trivially copyable keys and data, and an arena with the bytes of
+     * the std::string keys and data. The constructor maps the file and the table answers lookups at
+     * once, nothing is deserialized: the first lookups cost page faults instead of a reinsertion of
+     * every element, and processes that map the same file share its pages.
+     *
+     * The slots use linear probing over a power of two capacity at SNAPSHOT_LOAD_FACTOR, with a 7-bit
+     * fingerprint of the hash in the control byte. The file keeps the byte order of the machine that
+     * wrote it and a tag of the key and data types, their sizes and kinds (see tools::typeKind): a
+     * mismatch is refused by the constructor, as are offsets past the file. With std::string keys or
+     * data the constructor checks every StringRef against the arena, a pass over the slots.
+     *
+     * @tparam Thash hash of the keys. The reader must use the same one as the writer and its result
+     * must not depend on the process (no random seed).
+     *
+     * POSIX only (mmap). The errors of the files throw std::runtime_error.
+     */
+    template <class Tkey, class Tdata, class Thash = HashFunctions::FunctionFibonacci<Tkey>>
+    class Snapshot
+    {
+    private:
+        using StoredKey = typeNode::Stored<Tkey>;
+        using StoredData = typeNode::Stored<Tdata>;
+
+        struct Header
+        {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t slotSize;
+            std::uint32_t keySize;
+            std::uint32_t dataSize;
+            std::uint32_t keyKind;
+            std::uint32_t dataKind;
+            std::uint32_t capacity;
+            std::uint32_t size;
+            std::uint64_t controlsOffset;
+            std::uint64_t slotsOffset;
+            std::uint64_t arenaOffset;
+            std::uint64_t fileSize;
+        };
+
+    public:
+        struct Slot
+        {
+            typename StoredKey::t_stored key;
+            typename StoredData::t_stored data;
+        };
+
+    private:
+        const char *file = nullptr;
+        std::uint64_t fileSize = 0;
+
+        const typeNode::consts::t_control *controls = nullptr;
+        const Slot *slots = nullptr;
+        const char *arena = nullptr;
+        consts::t_uIndex _capacity = 0;
+        consts::t_uIndex _size = 0;
+
+        policy::CapacityPowerOfTwo<Tkey, Thash> capacityPolicy{0};
+
+        static typeNode::consts::t_control fingerprint(const consts::t_uHash &hash) noexcept
+        {
+            return static_cast<typeNode::consts::t_control>(hash & 0x7F);
+        }
+
+        static std::uint64_t align(const std::uint64_t &offset) noexcept
+        {
+            return (offset + consts::SNAPSHOT_ALIGNMENT - 1) / consts::SNAPSHOT_ALIGNMENT * consts::SNAPSHOT_ALIGNMENT;
+        }
+
+        // "error" is the errno of the failed call, taken before a close or an unlink can change it.
+        [[noreturn]] static void fail(const std::string &what, const std::string &path, const int error)
+        {
+            throw std::runtime_error("Snapshot: " + what + " " + path + ": " + std::strerror(error));
+        }
+
+        // Closes the temporary file of write if "descriptor" is open, removes the file and fails.
+        [[noreturn]] static void abandon(const std::string &what, const std::string &temporary, const int descriptor, const int error)
+        {
+            if (descriptor >= 0)
+                close(descriptor);
+
+            unlink(temporary.c_str());
+            fail(what, temporary, error);
+        }
+
+        // Every StringRef of an occupied slot lies within the arena.
+        bool validReferences(const std::uint64_t &arenaSize) const noexcept
+        {
+            for (consts::t_uIndex i = 0; i < this->_capacity; ++i)
+            {
+                if (this->controls[i] == typeNode::consts::CONTROL_EMPTY)
+                    continue;
+
+                if (!StoredKey::valid(this->slots[i].key, arenaSize) || !StoredData::valid(this->slots[i].data, arenaSize))
+                    return false;
+            }
+
+            return true;
+        }
+
+        void release() noexcept
+        {
+            if (this->file)
+                munmap(const_cast<char *>(this->file), this->fileSize);
+
+            this->file = nullptr;
+        }
+
+    public:
+        /**
+         * Writes the elements of a table (any table with a const iterator over {key, data} items,
+         * e.g. LinearProbing) to "path". The file is built under a temporary name, mapped, and
+         * renamed over "path" only when complete; on an error the temporary file is removed.
+         */
+        template <class Ttable>
+        static void write(const Ttable &table, const std::string &path) noexcept(false)
+        {
+            consts::t_uIndex capacity = policy::CapacityPowerOfTwo<Tkey, Thash>::round(static_cast<consts::t_uIndex>(table.size() / consts::SNAPSHOT_LOAD_FACTOR) + 1);
+            std::uint64_t arenaSize = 0;
+
+            for (const auto &item : table)
+                arenaSize += StoredKey::arenaSize(item.key) + StoredData::arenaSize(item.data);
+
+            Header header{consts::SNAPSHOT_MAGIC, consts::SNAPSHOT_VERSION, static_cast<std::uint32_t>(sizeof(Slot)), sizeof(Tkey), sizeof(Tdata), tools::typeKind<Tkey>(), tools::typeKind<Tdata>(), capacity, table.size(), 0, 0, 0, 0};
+
+            header.controlsOffset = align(sizeof(Header));
+            header.slotsOffset = align(header.controlsOffset + capacity);
+            header.arenaOffset = align(header.slotsOffset + static_cast<std::uint64_t>(capacity) * sizeof(Slot));
+            header.fileSize = header.arenaOffset + arenaSize;
+
+            std::string temporary = path + ".tmp";
+            int descriptor = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+            if (descriptor < 0)
+                fail("cannot create", temporary, errno);
+
+            if (ftruncate(descriptor, static_cast<off_t>(header.fileSize)) != 0)
+                abandon("cannot size", temporary, descriptor, errno);
+
+            void *mapped = mmap(nullptr, header.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+            if (mapped == MAP_FAILED)
+                abandon("cannot map", temporary, descriptor, errno);
+
+            close(descriptor);
+
+            char *base = static_cast<char *>(mapped);
+            auto *controls = reinterpret_cast<typeNode::consts::t_control *>(base + header.controlsOffset);
+            auto *slots = reinterpret_cast<Slot *>(base + header.slotsOffset);
+            char *arena = base + header.arenaOffset;
+            std::uint64_t used = 0;
+            policy::CapacityPowerOfTwo<Tkey, Thash> capacityPolicy(capacity);
+
+            std::memcpy(base, &header, sizeof(Header));
+            std::memset(controls, typeNode::consts::CONTROL_EMPTY, capacity);
+
+            // The keys of a table are distinct: every one takes the first free slot of its sequence.
+            for (const auto &item : table)
+            {
+                consts::t_uHash hash = capacityPolicy.hash(item.key);
+                consts::t_uIndex index = capacityPolicy.indexOf(hash);
+
+                while (controls[index] != typeNode::consts::CONTROL_EMPTY)
+                    index = capacityPolicy.next(index);
+
+                controls[index] = fingerprint(hash);
+                new (&slots[index]) Slot{StoredKey::store(item.key, arena, used), StoredData::store(item.data, arena, used)};
+            }
+
+            if (msync(mapped, header.fileSize, MS_SYNC) != 0)
+            {
+                int error = errno;
+
+                munmap(mapped, header.fileSize);
+                abandon("cannot write", temporary, -1, error);
+            }
+
+            munmap(mapped, header.fileSize);
+
+            if (std::rename(temporary.c_str(), path.c_str()) != 0)
+                abandon("cannot rename to " + path + " from", temporary, -1, errno);
+        }
+
+        // Maps the snapshot "path" read-only.
+        explicit Snapshot(const std::string &path) noexcept(false)
+        {
+            int descriptor = open(path.c_str(), O_RDONLY);
+            struct stat status;
+
+            if (descriptor < 0)
+                fail("cannot open", path, errno);
+
+            if (fstat(descriptor, &status) != 0)
+            {
+                int error = errno;
+
+                close(descriptor);
+                fail("cannot open", path, error);
+            }
+
+            if (static_cast<std::uint64_t>(status.st_size) < sizeof(Header))
+            {
+                close(descriptor);
+                fail("not a snapshot", path, EINVAL);
+            }
+
+            void *mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+            int error = errno;
+
+            close(descriptor);
+
+            if (mapped == MAP_FAILED)
+                fail("cannot map", path, error);
+
+            this->file = static_cast<const char *>(mapped);
+            this->fileSize = status.st_size;
+
+            const Header *header = reinterpret_cast<const Header *>(this->file);
+            bool valid = header->magic == consts::SNAPSHOT_MAGIC && header->version == consts::SNAPSHOT_VERSION && header->slotSize == sizeof(Slot) && header->keySize == sizeof(Tkey) && header->dataSize == sizeof(Tdata) && header->keyKind == tools::typeKind<Tkey>() && header->dataKind == tools::typeKind<Tdata>() && header->fileSize == this->fileSize && header->capacity && !(header->capacity & (header->capacity - 1)) && header->size < header->capacity && header->controlsOffset + header->capacity <= header->slotsOffset && header->slotsOffset + static_cast<std::uint64_t>(header->capacity) * sizeof(Slot) <= header->arenaOffset && header->arenaOffset <= header->fileSize;
+
+            if (!valid)
+            {
+                this->release();
+                fail("not a snapshot of these types", path, EINVAL);
+            }
+
+            this->controls = reinterpret_cast<const typeNode::consts::t_control *>(this->file + header->controlsOffset);
+            this->slots = reinterpret_cast<const Slot *>(this->file + header->slotsOffset);
+            this->arena = this->file + header->arenaOffset;
+            this->_capacity = header->capacity;
+            this->_size = header->size;
+            this->capacityPolicy.resize(this->_capacity);
+
+            if constexpr (StoredKey::REFERENCES || StoredData::REFERENCES)
+            {
+                if (!this->validReferences(this->fileSize - header->arenaOffset))
+                {
+                    this->release();
+                    fail("a string past the end of", path, EINVAL);
+                }
+            }
+        }
+
+        Snapshot(const Snapshot &) = delete;
+        Snapshot &operator=(const Snapshot &) = delete;
+
+        Snapshot(Snapshot &&other) noexcept : file(other.file), fileSize(other.fileSize), controls(other.controls), slots(other.slots), arena(other.arena), _capacity(other._capacity), _size(other._size), capacityPolicy(other.capacityPolicy)
+        {
+            other.file = nullptr;
+            other._capacity = other._size = 0;
+        }
+
+        consts::t_uIndex size() const noexcept
+        {
+            return _size;
+        }
+
+        consts::t_uIndex capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        // Bytes of the file, all of them mapped.
+        std::uint64_t bytes() const noexcept
+        {
+            return fileSize;
+        }
+
+        /**
+         * Slot of the key, nullptr if there is no such key. The slot lies in the mapping: its key and
+         * data are the stored ones, text() gives a std::string of them. Keys of any type the hash and
+         * the equality of Tkey accept, e.g. std::string_view for std::string keys.
+         */
+        template <class Tother>
+        const Slot *search(const Tother &key) const
+        {
+            if (!_capacity)
+                return nullptr;
+
+            consts::t_uHash hash = this->capacityPolicy.hash(key);
+            typeNode::consts::t_control control = fingerprint(hash);
+            consts::t_uIndex index = this->capacityPolicy.indexOf(hash);
+
+            // A written file has a free slot, see SNAPSHOT_LOAD_FACTOR; the bound stops the probe of a corrupt one.
+            for (consts::t_uIndex step = 0; step < this->_capacity && this->controls[index] != typeNode::consts::CONTROL_EMPTY; ++step, index = this->capacityPolicy.next(index))
+            {
+                if (this->controls[index] == control && StoredKey::equal(this->slots[index].key, this->arena, key))
+                    return &this->slots[index];
+            }
+
+            return nullptr;
+        }
+
+        template <class Tother>
+        bool containsKey(const Tother &key) const
+        {
+            return this->search(key);
+        }
+
+        // The bytes of a stored std::string.
+        std::string_view text(const typeNode::StringRef &stored) const noexcept
+        {
+            return std::string_view(this->arena + stored.offset, stored.length);
+        }
+
+        ~Snapshot()
+        {
+            this->release();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * Lookups of random present keys one by one with search and BATCH at a time with searchBatch,
+ * for a table that fits in the cache and for tables larger than the caches, where every lookup
+ * is a cache miss. Every result goes through "work" rounds of dependent multiplications, the
+ * rest of a request path: with no work the processor already overlaps the misses of a plain
+ * search loop by itself, with some work only the prefetches of a batch make them overlap.
+ * Prints the time per key and the speedup of the batches.
+ *
+ * Build: g++ -std=c++17 -O2 BatchLookup.cpp -o BatchLookup
+ */
+
+using t_key = long long;
+using HashTable::policy::CapacityPowerOfTwo;
+
+const unsigned int LOOKUPS = 1 << 22;
+const unsigned int BATCH = 256;
+
+
+unsigned long long sink = 0;
+
+// Work of the request path on every result: a dependent chain of multiplications. It fills the
+// reorder buffer of the processor, so the cache misses of the following searches do not start early.
+template <class Tresult>
+unsigned int work(Tresult result, unsigned int rounds)
+{
+    unsigned long long value = reinterpret_cast<unsigned long long>(result);
+
+    for (unsigned int i = 0; i < rounds; ++i)
+        value = value * 0x9E3779B97F4A7C15ull + i;
+
+    sink += value;
+    return result != nullptr;
+}
+
+template <class Ttable, class Tresult>
+void measure(const char *name, unsigned int size)
+{
+    std::mt19937_64 random(size);
+    std::vector<t_key> keys(size);
+    Ttable table;
+
+    for (t_key &key : keys)
+    {
+        key = static_cast<t_key>(random());
+        table.add(key, key);
+    }
+
+    std::vector<t_key> lookups(LOOKUPS);
+
+    for (t_key &key : lookups)
+        key = keys[random() % size];
+
+    std::vector<Tresult> results(BATCH);
+
+    for (unsigned int rounds : {0u, 40u})
+    {
+        unsigned long long found = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0; i < LOOKUPS; ++i)
+            found += work(table.search(lookups[i]), rounds);
+
+        auto single = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0; i < LOOKUPS; i += BATCH)
+        {
+            table.searchBatch(lookups.data() + i, BATCH, results.data());
+
+            for (Tresult result : results)
+                found += work(result, rounds);
+        }
+
+        auto batched = std::chrono::steady_clock::now();
+
+        double singleTime = std::chrono::duration<double, std::nano>(single - start).count() / LOOKUPS;
+        double batchTime = std::chrono::duration<double, std::nano>(batched - single).count() / LOOKUPS;
+
+        std::printf("%-26s %10u %8u %12.1f %12.1f %10.2f %8s\n", name, size, rounds, singleTime, batchTime, singleTime / batchTime,
+                    found == 2ull * LOOKUPS ? "" : "error");
+        std::fflush(stdout);
+    }
+}
+
+int main()
+{
+    using t_linear = HashTable::LinearProbing<t_key, t_key, CapacityPowerOfTwo<t_key>>;
+    using t_chain = HashTable::LinearProbingChainMethod<t_key, t_key, CapacityPowerOfTwo<t_key>>;
+    using t_node = HashTable::typeNode::Chain<t_key, t_key>::Node *;
+
+    std::printf("%u lookups of present keys, batches of %u\n\n", LOOKUPS, BATCH);
+    std::printf("%-26s %10s %8s %12s %12s %10s\n", "table", "size", "work", "search, ns", "batch, ns", "speedup");
+
+    for (unsigned int size : {1u << 12, 1u << 20, 1u << 24})
+    {
+        measure<t_linear, t_key *>("LinearProbing", size);
+        measure<t_chain, t_node>("LinearProbingChainMethod", size);
+    }
+}
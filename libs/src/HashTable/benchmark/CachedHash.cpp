@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+#include "../HashFunctions/FunctionWyhash.cc"
+
+/**
+ * Long string keys with a common prefix, with and without the hash cached in the slots (cacheHash).
+ * For every table prints the time to build it by adds from the default capacity (all the
+ * reCapacity rebuilds included), the time of the hits and of the misses.
+ *
+ * Build: g++ -std=c++17 -O2 CachedHash.cpp -o CachedHash
+ */
+
+using HashTable::policy::CapacityPowerOfTwo;
+using HashTable::policy::KeyEqual;
+using HashTable::policy::ProbeLinear;
+using t_capacity = CapacityPowerOfTwo<std::string, HashFunctions::FunctionWyhash>;
+
+const unsigned int SIZE = 1 << 18;
+const unsigned int KEY_LENGTH = 256;
+
+// Keys differ only in the tail, present and missing keys differ in the tag.
+std::vector<std::string> makeKeys(std::mt19937 &random, unsigned int count, char tag)
+{
+    std::vector<std::string> result;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        std::string key(KEY_LENGTH - 16, tag);
+        key += std::to_string(random());
+        key.resize(KEY_LENGTH, '0');
+        result.push_back(key);
+    }
+
+    return result;
+}
+
+template <class Ttable>
+void measure(const char *name, const std::vector<std::string> &keys, const std::vector<std::string> &misses)
+{
+    Ttable table;
+    unsigned int found = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (const std::string &key : keys)
+        table.add(key, 0);
+
+    auto built = std::chrono::steady_clock::now();
+
+    for (const std::string &key : keys)
+        found += table.containsKey(key);
+
+    auto hit = std::chrono::steady_clock::now();
+
+    for (const std::string &key : misses)
+        found -= table.containsKey(key);
+
+    auto missed = std::chrono::steady_clock::now();
+
+    std::printf("%-28s %12.1f %12.1f %12.1f %8s\n", name,
+                std::chrono::duration<double, std::milli>(built - start).count(),
+                std::chrono::duration<double, std::nano>(hit - built).count() / keys.size(),
+                std::chrono::duration<double, std::nano>(missed - hit).count() / misses.size(),
+                found == keys.size() ? "" : "error");
+    std::fflush(stdout);
+}
+
+int main()
+{
+    std::mt19937 random(1);
+    std::vector<std::string> keys = makeKeys(random, SIZE, 'k');
+    std::vector<std::string> misses = makeKeys(random, SIZE, 'm');
+
+    std::printf("%u keys of %u bytes\n\n", SIZE, KEY_LENGTH);
+    std::printf("%-28s %12s %12s %12s\n", "table", "build, ms", "hit, ns", "miss, ns");
+
+    measure<HashTable::LinearProbing<std::string, int, t_capacity>>("linear", keys, misses);
+    measure<HashTable::LinearProbing<std::string, int, t_capacity, KeyEqual<std::string>, ProbeLinear, true>>("linear, cached hash", keys, misses);
+    measure<HashTable::LinearProbingChainMethod<std::string, int, t_capacity>>("chain", keys, misses);
+    measure<HashTable::LinearProbingChainMethod<std::string, int, t_capacity, KeyEqual<std::string>, true>>("chain, cached hash", keys, misses);
+}
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * LinearProbingChainMethod with Chain buckets (a linked list of nodes) and with UnrolledBucket
+ * buckets (the first elements in the bucket's own cache line): time per lookup of random present
+ * and absent keys, for tables in the cache and larger than the caches, at the default load factors
+ * (0.25..0.75) and with the maximum raised to 0.95, where more buckets hold several keys. The
+ * sizes are about 0.9 of a power of two, so the second table does not grow at the last keys.
+ *
+ * Build: g++ -std=c++17 -O2 ChainBuckets.cpp -o ChainBuckets
+ */
+
+using t_key = long long;
+using HashTable::policy::CapacityPowerOfTwo;
+using HashTable::policy::KeyEqual;
+
+const unsigned int LOOKUPS = 1 << 22;
+
+template <class Ttable>
+void measure(const char *name, unsigned int size, HashTable::consts::t_stat loadFactorMin, HashTable::consts::t_stat loadFactorMax)
+{
+    std::mt19937_64 random(size);
+    std::vector<t_key> keys(size);
+    Ttable table(HashTable::consts::DEFAULT_CAPACITY, loadFactorMin, loadFactorMax);
+
+    for (t_key &key : keys)
+    {
+        key = static_cast<t_key>(random());
+        table.add(key, key);
+    }
+
+    std::vector<t_key> present(LOOKUPS), absent(LOOKUPS);
+
+    for (unsigned int i = 0; i < LOOKUPS; ++i)
+    {
+        present[i] = keys[random() % size];
+        absent[i] = static_cast<t_key>(random());
+    }
+
+    unsigned long long found = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (t_key key : present)
+        found += table.search(key) != nullptr;
+
+    auto middle = std::chrono::steady_clock::now();
+
+    for (t_key key : absent)
+        found += table.search(key) != nullptr;
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%-16s %10u %10.2f %12.1f %12.1f %8s\n", name, size, table.loadFactor(),
+                std::chrono::duration<double, std::nano>(middle - start).count() / LOOKUPS,
+                std::chrono::duration<double, std::nano>(end - middle).count() / LOOKUPS,
+                found == LOOKUPS ? "" : "error");
+    std::fflush(stdout);
+}
+
+int main()
+{
+    using t_chain = HashTable::LinearProbingChainMethod<t_key, t_key, CapacityPowerOfTwo<t_key>>;
+    using t_unrolled = HashTable::LinearProbingChainMethod<t_key, t_key, CapacityPowerOfTwo<t_key>, KeyEqual<t_key>, false, HashTable::policy::AllocatorNew, HashTable::typeNode::UnrolledBucket>;
+
+    std::printf("%u lookups of present and absent keys, %u keys per unrolled block\n\n", LOOKUPS, HashTable::typeNode::UnrolledBucket<t_key, t_key>::BLOCK_SIZE);
+    std::printf("%-16s %10s %10s %12s %12s\n", "bucket", "size", "load", "present, ns", "absent, ns");
+
+    for (unsigned int size : {3700u, 940000u, 7500000u})
+    {
+        measure<t_chain>("Chain", size, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, HashTable::consts::DEFAULT_LOAD_FACTOR_MAX);
+        measure<t_unrolled>("UnrolledBucket", size, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, HashTable::consts::DEFAULT_LOAD_FACTOR_MAX);
+    }
+
+    for (unsigned int size : {3700u, 940000u, 7500000u})
+    {
+        measure<t_chain>("Chain", size, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, 0.95f);
+        measure<t_unrolled>("UnrolledBucket", size, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, 0.95f);
+    }
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentSharded.cc"
+#include "../HashTable/sync/SpinLock.cc"
+
+/**
+ * Throughput of a mixed workload from 1 thread up to all the cores: every thread runs OPERATIONS
+ * operations on random keys of a table prefilled with SIZE keys, a "read" share of them are
+ * searches, the rest insert or remove a key. Compares one LinearProbing behind a global mutex
+ * with ConcurrentSharded over reader-writer locks and over spin locks. The first argument sets the
+ * largest number of threads, all the cores by default.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread ConcurrentScaling.cpp -o ConcurrentScaling
+ */
+
+using t_key = long long;
+using t_linear = HashTable::LinearProbing<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>;
+
+const unsigned int SIZE = 1 << 20;
+const unsigned int OPERATIONS = 1 << 20;
+
+// The table as it is used without ConcurrentSharded.
+class GlobalMutex
+{
+private:
+    std::mutex lock;
+    t_linear table;
+
+public:
+    bool search(const t_key &key, t_key &data)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        t_key *found = table.search(key);
+
+        if (found)
+            data = *found;
+        return found;
+    }
+
+    bool insert(const t_key &key, const t_key &data)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return table.insert(key, data);
+    }
+
+    bool remove(const t_key &key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return table.remove(key);
+    }
+};
+
+template <class Ttable>
+double measure(Ttable &table, unsigned int threads, unsigned int readPercent)
+{
+    std::vector<std::thread> workers;
+    std::vector<unsigned long long> found(threads);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([&table, &found, thread, readPercent]() {
+            std::mt19937_64 random(thread + 1);
+            t_key data;
+
+            for (unsigned int i = 0; i < OPERATIONS; ++i)
+            {
+                t_key key = static_cast<t_key>(random() % (2 * SIZE));
+
+                if (random() % 100 < readPercent)
+                    found[thread] += table.search(key, data);
+                else if (i & 1)
+                    table.insert(key, key);
+                else
+                    table.remove(key);
+            }
+        });
+    }
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return threads * OPERATIONS / seconds / 1e6;
+}
+
+template <class Ttable>
+void measureAll(const char *name, const std::vector<unsigned int> &threadCounts)
+{
+    for (unsigned int readPercent : {100u, 90u, 50u})
+    {
+        Ttable table;
+
+        for (unsigned int i = 0; i < SIZE; ++i)
+            table.insert(static_cast<t_key>(2 * i), 2 * i);
+
+        std::printf("%-28s %6u%%", name, readPercent);
+
+        for (unsigned int threads : threadCounts)
+            std::printf(" %10.2f", measure(table, threads, readPercent));
+
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // The number of threads to go up to, all the cores by default.
+    unsigned int cores = argc > 1 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> threadCounts;
+
+    for (unsigned int threads = 1; threads < cores; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(cores);
+
+    std::printf("%u operations per thread on %u keys, up to %u threads, millions of operations per second\n\n", OPERATIONS, SIZE, cores);
+    std::printf("%-28s %7s", "table", "reads");
+
+    for (unsigned int threads : threadCounts)
+        std::printf(" %7u thr", threads);
+
+    std::printf("\n");
+
+    measureAll<GlobalMutex>("global mutex", threadCounts);
+    measureAll<HashTable::ConcurrentSharded<t_key, t_key>>("sharded, shared_mutex", threadCounts);
+    measureAll<HashTable::ConcurrentSharded<t_key, t_key, t_linear, HashFunctions::FunctionFibonacci<t_key>, HashTable::sync::SpinLock>>("sharded, spin lock", threadCounts);
+}
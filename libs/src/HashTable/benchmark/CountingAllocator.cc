@@ -0,0 +1,151 @@
+#ifndef __HashTable_benchmark_CountingAllocator__
+#define __HashTable_benchmark_CountingAllocator__
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Replacements of every global operator new and delete that count the allocations in "allocations",
+ * for the benchmarks that print heap allocations. Include it in one translation unit of a program.
+ * The memory comes from malloc and aligned_alloc, and goes back through free.
+ */
+
+unsigned long long allocations = 0;
+
+namespace countingAllocator
+{
+    void *allocate(std::size_t size, const std::size_t &alignment) noexcept
+    {
+        ++allocations;
+
+        if (!size)
+            size = 1;
+
+        if (alignment <= alignof(std::max_align_t))
+            return std::malloc(size);
+
+        // aligned_alloc takes a size that is a multiple of the alignment.
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    void *allocateOrThrow(const std::size_t &size, const std::size_t &alignment) noexcept(false)
+    {
+        if (void *result = allocate(size, alignment))
+            return result;
+
+        throw std::bad_alloc();
+    }
+
+    // Kept out of line: inlined into a caller, GCC sees free() take the result of operator new and
+    // reports -Wmismatched-new-delete although both ends are replaced here.
+#if defined(__GNUC__)
+    __attribute__((noinline))
+#endif
+    void release(void *pointer) noexcept
+    {
+        std::free(pointer);
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    return countingAllocator::allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size)
+{
+    return countingAllocator::allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countingAllocator::allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countingAllocator::allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return countingAllocator::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return countingAllocator::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countingAllocator::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countingAllocator::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    countingAllocator::release(pointer);
+}
+
+#endif
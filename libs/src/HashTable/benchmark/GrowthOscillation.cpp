@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * A table of BASE keys that repeatedly gets a batch of more keys and loses them again, with three
+ * growth policies: the capacity grown up to loadFactorMin and shrunk as soon as the load factor is
+ * under it (how reCapacity worked before policy::Growth), geometric growth by 2 with the shrink
+ * threshold at half of loadFactorMin (the default), and growth by 2 without shrinking. The batches
+ * take the load factor over the maximum and back: BASE keys with the load factors 0.5..0.75,
+ * 2 * BASE keys with the default ones. Prints the number of capacity changes over CYCLES rounds and
+ * the total time.
+ *
+ * Build: g++ -std=c++17 -O2 GrowthOscillation.cpp -o GrowthOscillation
+ */
+
+using t_key = long long;
+
+const unsigned int BASE = 50000;
+const unsigned int CYCLES = 200;
+
+template <class Ttable>
+void measure(const char *name, const char *policy, const HashTable::policy::Growth &growth, const std::vector<t_key> &keys, unsigned int batch, HashTable::consts::t_stat loadFactorMin)
+{
+    Ttable table(HashTable::consts::DEFAULT_CAPACITY, loadFactorMin, HashTable::consts::DEFAULT_LOAD_FACTOR_MAX);
+    unsigned int resizes = 0;
+
+    table.setGrowth(growth);
+
+    for (unsigned int i = 0; i < BASE; ++i)
+        table.add(keys[i], keys[i]);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int cycle = 0; cycle < CYCLES; ++cycle)
+    {
+        for (unsigned int i = BASE; i < BASE + batch; ++i)
+        {
+            unsigned int capacity = table.capacity();
+
+            table.add(keys[i], keys[i]);
+            resizes += table.capacity() != capacity;
+        }
+
+        for (unsigned int i = BASE; i < BASE + batch; ++i)
+        {
+            unsigned int capacity = table.capacity();
+
+            table.remove(keys[i]);
+            resizes += table.capacity() != capacity;
+        }
+    }
+
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-26s %-14s %6.2f %8u %10u %10u %10.1f %8s\n", name, policy, loadFactorMin, batch, table.capacity(), resizes, time, table.size() == BASE ? "" : "error");
+    std::fflush(stdout);
+}
+
+template <class Ttable>
+void measure(const char *name, const std::vector<t_key> &keys)
+{
+    const struct
+    {
+        unsigned int batch;
+        HashTable::consts::t_stat loadFactorMin;
+    } loads[] = {{BASE, 0.5f}, {2 * BASE, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN}};
+
+    for (const auto &load : loads)
+    {
+        // A factor this large is capped at loadFactorMin, as the old growth.
+        measure<Ttable>(name, "shrink at min", HashTable::policy::Growth::geometric(100, 1), keys, load.batch, load.loadFactorMin);
+        measure<Ttable>(name, "hysteresis", HashTable::policy::Growth::geometric(), keys, load.batch, load.loadFactorMin);
+        measure<Ttable>(name, "never shrink", HashTable::policy::Growth::neverShrink(), keys, load.batch, load.loadFactorMin);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    std::vector<t_key> keys(3 * BASE);
+
+    for (t_key &key : keys)
+        key = static_cast<t_key>(random());
+
+    std::printf("%u keys, %u rounds of adding a batch of keys and removing it, times in ms\n\n", BASE, CYCLES);
+    std::printf("%-26s %-14s %6s %8s %10s %10s %10s\n", "table", "policy", "min", "batch", "capacity", "resizes", "time");
+
+    measure<HashTable::LinearProbing<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>>("LinearProbing", keys);
+    measure<HashTable::LinearProbingChainMethod<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>>("LinearProbingChainMethod", keys);
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../HashFunctions/FunctionWyhash.cc"
+#include "CountingAllocator.cc"
+
+/**
+ * Lookups of std::string keys by std::string_view slices of one input buffer, the way a parser
+ * sees its tokens: with a temporary std::string built for every lookup and with the slice passed
+ * as is (heterogeneous lookup). Prints the heap allocations and the time per lookup.
+ *
+ * Build: g++ -std=c++17 -O2 HeterogeneousLookup.cpp -o HeterogeneousLookup
+ */
+
+using HashTable::policy::CapacityPowerOfTwo;
+
+const unsigned int SIZE = 1 << 16;
+const unsigned int LOOKUPS = 1 << 22;
+
+// Identifiers longer than the small string buffer, so a temporary std::string allocates.
+std::string makeIdentifier(unsigned int number)
+{
+    return "identifier_of_the_parser_" + std::to_string(number);
+}
+
+template <class Ttable, class Tlookup>
+void measure(const char *name, const std::vector<std::string_view> &tokens, Tlookup lookup)
+{
+    Ttable table;
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        table.add(makeIdentifier(i), i);
+
+    unsigned long long found = 0;
+    unsigned long long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::string_view token : tokens)
+        found += lookup(table, token);
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-36s %18.2f %12.1f %8s\n", name, static_cast<double>(allocations - before) / tokens.size(), nanoseconds / tokens.size(),
+                found == tokens.size() ? "" : "error");
+    std::fflush(stdout);
+}
+
+template <class Ttable>
+void measureAll(const char *name, const std::vector<std::string_view> &tokens)
+{
+    std::printf("%s\n", name);
+
+    measure<Ttable>("  std::string(token)", tokens, [](Ttable &table, std::string_view token) { return table.containsKey(std::string(token)); });
+    measure<Ttable>("  token", tokens, [](Ttable &table, std::string_view token) { return table.containsKey(token); });
+}
+
+int main()
+{
+    std::mt19937 random(1);
+    std::string buffer;
+    std::vector<std::pair<size_t, size_t>> spans;
+
+    for (unsigned int i = 0; i < LOOKUPS; ++i)
+    {
+        std::string identifier = makeIdentifier(random() % SIZE);
+
+        spans.emplace_back(buffer.size(), identifier.size());
+        buffer += identifier;
+        buffer += ' ';
+    }
+
+    std::vector<std::string_view> tokens;
+
+    for (const std::pair<size_t, size_t> &span : spans)
+        tokens.push_back(std::string_view(buffer).substr(span.first, span.second));
+
+    std::printf("%u lookups of %u keys by slices of a %zu byte buffer\n\n", LOOKUPS, SIZE, buffer.size());
+    std::printf("%-36s %18s %12s\n", "table, key", "allocations/lookup", "time, ns");
+
+    measureAll<HashTable::LinearProbing<std::string, unsigned int, CapacityPowerOfTwo<std::string>>>("LinearProbing, FNV-1a", tokens);
+    measureAll<HashTable::LinearProbing<std::string, unsigned int, CapacityPowerOfTwo<std::string, HashFunctions::FunctionWyhash>>>("LinearProbing, wyhash", tokens);
+}
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../HashFunctions/FunctionSplitMix.cc"
+#include "../HashFunctions/FunctionMurmur.cc"
+
+/**
+ * Integer key patterns that break weak hashes: sequential, strided (shared low bits),
+ * clustered runs, negative and random keys. For every pattern and hash prints the maximum
+ * and the mean probe length of LinearProbing after SIZE adds, and the build time.
+ *
+ * The "error" column is a check of the hash: it is set when the keys fall into fewer than a
+ * quarter as many home slots as there are keys, e.g. when keys that differ only in the high
+ * 32 bits ("stride 2^32") are truncated to the same home slot.
+ *
+ * Build: g++ -std=c++17 -O2 IntegerKeys.cpp -o IntegerKeys
+ */
+
+using t_key = long long;
+
+const unsigned int SIZE = 1 << 18;
+
+template <class Tcapacity>
+class MeasuredTable : public HashTable::LinearProbing<t_key, int, Tcapacity>
+{
+public:
+    using HashTable::LinearProbing<t_key, int, Tcapacity>::LinearProbing;
+
+    void probeLengths(unsigned int &max, double &mean, unsigned int &homes) const
+    {
+        std::unordered_set<unsigned int> distinct;
+        unsigned long long sum = 0;
+        max = 0;
+
+        for (unsigned int i = 0; i < this->capacity(); ++i)
+        {
+            if (!this->table.isOccupied(i))
+                continue;
+
+            unsigned int home = this->capacityPolicy.index(this->table.getKey(i));
+            unsigned int length = i >= home ? i - home : i + this->capacity() - home;
+
+            sum += length;
+            max = length > max ? length : max;
+            distinct.insert(home);
+        }
+
+        mean = static_cast<double>(sum) / this->size();
+        homes = static_cast<unsigned int>(distinct.size());
+    }
+};
+
+template <class Tcapacity>
+void measure(const char *pattern, const char *name, const std::vector<t_key> &keys, const Tcapacity &capacityPolicy)
+{
+    MeasuredTable<Tcapacity> table(HashTable::consts::DEFAULT_CAPACITY, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, HashTable::consts::DEFAULT_LOAD_FACTOR_MAX, capacityPolicy);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (t_key key : keys)
+        table.add(key, 0);
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned int max;
+    unsigned int homes;
+    double mean;
+    table.probeLengths(max, mean, homes);
+
+    std::printf("%-12s %-18s %10u %10u %12.2f %10.1f %8s\n", pattern, name, table.size(), max, mean, milliseconds, homes * 4 < table.size() ? "error" : "");
+    std::fflush(stdout);
+}
+
+void measureAll(const char *pattern, const std::vector<t_key> &keys)
+{
+    using HashTable::policy::CapacityModulus;
+    using HashTable::policy::CapacityPowerOfTwo;
+
+    measure(pattern, "modulus", keys, CapacityModulus<t_key>(0));
+    measure(pattern, "fibonacci", keys, CapacityPowerOfTwo<t_key>(0));
+    measure(pattern, "splitmix", keys, CapacityPowerOfTwo<t_key, HashFunctions::FunctionSplitMix<t_key>>(0));
+    measure(pattern, "splitmix, seeded", keys, CapacityPowerOfTwo<t_key, HashFunctions::FunctionSplitMix<t_key>>(0, HashFunctions::FunctionSplitMix<t_key>(0x5EED)));
+    measure(pattern, "murmur", keys, CapacityPowerOfTwo<t_key, HashFunctions::FunctionMurmur<t_key>>(0));
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    std::vector<t_key> keys(SIZE);
+
+    std::printf("%-12s %-18s %10s %10s %12s %10s\n", "pattern", "hash", "size", "max probe", "mean probe", "build, ms");
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        keys[i] = i;
+    measureAll("sequential", keys);
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        keys[i] = static_cast<t_key>(i) << 12;
+    measureAll("stride 2^12", keys);
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        keys[i] = static_cast<t_key>(i) << 32;
+    measureAll("stride 2^32", keys);
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        keys[i] = (i % 1024 == 0 ? random() >> 24 : keys[i - 1] + 1);
+    measureAll("clustered", keys);
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        keys[i] = -static_cast<t_key>(i) * 3;
+    measureAll("negative", keys);
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        keys[i] = static_cast<t_key>(random());
+    measureAll("random", keys);
+}
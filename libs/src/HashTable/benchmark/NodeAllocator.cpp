@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../LinearProbingChainMethod.cc"
+#include "CountingAllocator.cc"
+
+/**
+ * LinearProbingChainMethod with a new and a delete per node (AllocatorNew) and with the nodes cut
+ * from large blocks (AllocatorPool): heap allocations and time to build a table of SIZE random
+ * keys by add from the default capacity, to churn it (remove half of the keys and add as many
+ * new ones) and to clear it. The allocations of the bucket arrays are counted too, they are the
+ * same for both.
+ *
+ * The heap keeps the memory freed by one run for the next ones, while the large blocks of the pool
+ * are fresh pages from the system. For fair build times of the large tables run every allocator in
+ * its own process with the argument "new" or "pool", without it both run.
+ *
+ * Build: g++ -std=c++17 -O2 NodeAllocator.cpp -o NodeAllocator
+ */
+
+using t_key = long long;
+using HashTable::policy::CapacityPowerOfTwo;
+using HashTable::policy::KeyEqual;
+
+double since(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Ttable>
+void measure(const char *name, const std::vector<t_key> &keys)
+{
+    unsigned int size = static_cast<unsigned int>(keys.size() / 2);
+    Ttable *table = new Ttable();
+
+    unsigned long long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < size; ++i)
+        table->add(keys[i], keys[i]);
+
+    double buildTime = since(start);
+    unsigned long long buildAllocations = allocations - before;
+
+    before = allocations;
+    start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < size; i += 2)
+    {
+        table->remove(keys[i]);
+        table->add(keys[size + i], keys[size + i]);
+    }
+
+    double churnTime = since(start);
+    unsigned long long churnAllocations = allocations - before;
+    bool good = table->size() == size;
+
+    start = std::chrono::steady_clock::now();
+    table->clear();
+    double clearTime = since(start);
+
+    delete table;
+
+    std::printf("%-16s %10u %14llu %10.1f %14llu %10.1f %10.1f %8s\n", name, size, buildAllocations, buildTime,
+                churnAllocations, churnTime, clearTime, good ? "" : "error");
+    std::fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    bool runNew = argc < 2 || std::strcmp(argv[1], "new") == 0;
+    bool runPool = argc < 2 || std::strcmp(argv[1], "pool") == 0;
+
+    std::printf("%-16s %10s %14s %10s %14s %10s %10s\n", "allocator", "size", "build, allocs", "build, ms", "churn, allocs", "churn, ms", "clear, ms");
+
+    for (unsigned int size : {1u << 16, 1u << 20, 10000000u})
+    {
+        // The first half is added, the second one replaces the removed keys.
+        std::mt19937_64 random(size);
+        std::vector<t_key> keys(2 * size);
+
+        for (t_key &key : keys)
+            key = static_cast<t_key>(random());
+
+        if (runNew)
+            measure<HashTable::LinearProbingChainMethod<t_key, t_key, CapacityPowerOfTwo<t_key>, KeyEqual<t_key>, false, HashTable::policy::AllocatorNew>>("AllocatorNew", keys);
+        if (runPool)
+            measure<HashTable::LinearProbingChainMethod<t_key, t_key, CapacityPowerOfTwo<t_key>, KeyEqual<t_key>, false, HashTable::policy::AllocatorPool>>("AllocatorPool", keys);
+    }
+}
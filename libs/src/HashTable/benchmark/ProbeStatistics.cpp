@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * Hit and miss lookups in LinearProbing and LinearProbingChainMethod of SIZE keys at several
+ * maximum load factors. Built with -DHASHTABLE_STATISTICS it also prints the mean probe lengths
+ * and the statistics of every table as JSON; the times of the two builds show what the counters cost.
+ *
+ * Build: g++ -std=c++17 -O2 ProbeStatistics.cpp -o ProbeStatistics
+ *        g++ -std=c++17 -O2 -DHASHTABLE_STATISTICS ProbeStatistics.cpp -o ProbeStatistics
+ */
+
+using t_key = long long;
+
+const unsigned int SIZE = 1800000;
+
+template <class Ttable>
+void measure(const char *name, HashTable::consts::t_stat loadFactorMax, const std::vector<t_key> &keys)
+{
+    Ttable table(HashTable::consts::DEFAULT_CAPACITY, HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, loadFactorMax);
+    unsigned int found = 0;
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        table.add(keys[i], keys[i]);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // The first SIZE keys are in the table, the others are not.
+    for (t_key key : keys)
+        found += table.containsKey(key);
+
+    double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / keys.size();
+
+    std::printf("%-26s %6.2f %10u %12.1f", name, loadFactorMax, table.capacity(), time);
+
+#ifdef HASHTABLE_STATISTICS
+    HashTable::Statistics statistics = table.statistics();
+
+    std::printf(" %8.2f %8.2f %8s\n", statistics.meanProbes(HashTable::Statistics::INSERT), statistics.meanProbes(HashTable::Statistics::SEARCH), found == SIZE ? "" : "error");
+    std::printf("%s\n", statistics.toJson().c_str());
+#else
+    std::printf(" %8s %8s %8s\n", "-", "-", found == SIZE ? "" : "error");
+#endif
+
+    std::fflush(stdout);
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    std::vector<t_key> keys(2 * SIZE);
+
+    for (t_key &key : keys)
+        key = static_cast<t_key>(random());
+
+    std::printf("%u keys, %u hit and miss lookups, statistics %s\n\n", SIZE, 2 * SIZE,
+#ifdef HASHTABLE_STATISTICS
+                "on"
+#else
+                "off"
+#endif
+    );
+    std::printf("%-26s %6s %10s %12s %8s %8s\n", "table", "max", "capacity", "lookup, ns", "insert", "search");
+
+    for (HashTable::consts::t_stat loadFactorMax : {0.5f, 0.75f, 0.9f})
+    {
+        measure<HashTable::LinearProbing<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>>("LinearProbing", loadFactorMax, keys);
+        measure<HashTable::LinearProbingChainMethod<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>>("LinearProbingChainMethod", loadFactorMax, keys);
+    }
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentLinearProbing.cc"
+#include "../ConcurrentSharded.cc"
+
+/**
+ * Lookup throughput of reader threads while one writer thread keeps inserting new keys into the
+ * same table, so the table also grows under the readers. Every reader searches random keys of a
+ * table prefilled with SIZE keys for SECONDS. Compares ConcurrentSharded over reader-writer locks,
+ * where every search writes the shared lock of its shard, with ConcurrentLinearProbing, where the
+ * searches write nothing shared. The first argument sets the largest number of readers, all the
+ * cores but the writer's by default. With fewer cores than threads the readers share the cores
+ * and the numbers do not scale.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread ReadMostly.cpp -o ReadMostly
+ */
+
+using t_key = long long;
+
+const unsigned int SIZE = 1 << 20;
+const double SECONDS = 0.5;
+
+template <class Ttable>
+void measure(const char *name, unsigned int readers)
+{
+    Ttable table;
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        table.insert(static_cast<t_key>(i), static_cast<t_key>(i));
+
+    std::atomic<bool> stop(false);
+    std::vector<unsigned long long> lookups(readers);
+    std::vector<unsigned long long> errors(readers);
+    unsigned long long inserts = 0;
+    std::vector<std::thread> threads;
+
+    for (unsigned int reader = 0; reader < readers; ++reader)
+    {
+        threads.emplace_back([&table, &stop, &lookups, &errors, reader]() {
+            std::mt19937_64 random(reader + 1);
+            t_key data = 0;
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                // The prefilled keys are never removed: every search has to find its key.
+                for (unsigned int i = 0; i < 256; ++i)
+                {
+                    t_key key = static_cast<t_key>(random() % SIZE);
+
+                    errors[reader] += !table.search(key, data) || data != key;
+                }
+
+                lookups[reader] += 256;
+            }
+        });
+    }
+
+    threads.emplace_back([&table, &stop, &inserts]() {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            t_key key = static_cast<t_key>(SIZE + inserts++);
+            table.insert(key, key);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(SECONDS));
+    stop.store(true);
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    unsigned long long total = 0;
+    unsigned long long error = 0;
+
+    for (unsigned int reader = 0; reader < readers; ++reader)
+    {
+        total += lookups[reader];
+        error += errors[reader];
+    }
+
+    std::printf("%-28s %8u %14.2f %14.2f %8s\n", name, readers, total / SECONDS / 1e6, inserts / SECONDS / 1e6, error ? "error" : "");
+    std::fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    unsigned int maxReaders = argc > 1 ? std::atoi(argv[1]) : std::max(1u, cores - 1);
+
+    std::printf("%u prefilled keys, 1 inserting writer, %.1f s per run, %u cores, millions per second\n\n", SIZE, SECONDS, cores);
+    std::printf("%-28s %8s %14s %14s\n", "table", "readers", "lookups", "inserts");
+
+    for (unsigned int readers = 1;; readers = std::min(readers * 2, maxReaders))
+    {
+        measure<HashTable::ConcurrentSharded<t_key, t_key>>("sharded, shared_mutex", readers);
+        measure<HashTable::ConcurrentLinearProbing<t_key, t_key>>("ConcurrentLinearProbing", readers);
+
+        if (readers == maxReaders)
+            break;
+    }
+}
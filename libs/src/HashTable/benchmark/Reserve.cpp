@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * Time to load SIZE random {key, data} pairs into LinearProbing and LinearProbingChainMethod: by
+ * add from the default capacity, by add after reserve(SIZE) and by the range constructor, with
+ * the number of times the capacity changed on the way.
+ *
+ * Build: g++ -std=c++17 -O2 Reserve.cpp -o Reserve
+ */
+
+using t_key = long long;
+using t_pairs = std::vector<std::pair<t_key, t_key>>;
+
+const unsigned int SIZE = 1 << 22;
+
+template <class Ttable>
+void print(const char *name, const char *how, const Ttable &table, unsigned int resizes, const std::chrono::steady_clock::time_point &start)
+{
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-26s %-12s %10u %10u %10.1f %8s\n", name, how, table.capacity(), resizes, time, table.size() == SIZE ? "" : "error");
+    std::fflush(stdout);
+}
+
+template <class Ttable>
+void add(Ttable &table, const t_pairs &pairs, const char *name, const char *how, const std::chrono::steady_clock::time_point &start)
+{
+    unsigned int resizes = 0;
+
+    for (const auto &pair : pairs)
+    {
+        unsigned int capacity = table.capacity();
+
+        table.add(pair.first, pair.second);
+        resizes += table.capacity() != capacity;
+    }
+
+    print(name, how, table, resizes, start);
+}
+
+template <class Ttable>
+void measure(const char *name, const t_pairs &pairs)
+{
+    {
+        auto start = std::chrono::steady_clock::now();
+        Ttable table;
+
+        add(table, pairs, name, "add", start);
+    }
+    {
+        auto start = std::chrono::steady_clock::now();
+        Ttable table;
+
+        table.reserve(SIZE);
+        add(table, pairs, name, "reserve, add", start);
+    }
+    {
+        auto start = std::chrono::steady_clock::now();
+        Ttable table(pairs.begin(), pairs.end());
+
+        print(name, "range", table, 0, start);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    t_pairs pairs(SIZE);
+
+    for (auto &pair : pairs)
+        pair.first = pair.second = static_cast<t_key>(random());
+
+    std::printf("%u random keys, times in ms\n\n", SIZE);
+    std::printf("%-26s %-12s %10s %10s %10s\n", "table", "load", "capacity", "resizes", "time");
+
+    measure<HashTable::LinearProbing<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>>("LinearProbing", pairs);
+    measure<HashTable::LinearProbingChainMethod<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>>("LinearProbingChainMethod", pairs);
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../LinearProbing.cc"
+
+/**
+ * Latency of every single add while a table grows from the default capacity to SIZE elements,
+ * with the stop-the-world reCapacity and with the incremental rehash. Prints the percentiles,
+ * the slowest add and the total time; the adds of the incremental rehash also split into those
+ * made while a move was in progress, the one that started it and the one that ended it (and freed
+ * the old array). The "timer" row times an empty operation the same way: its max is the noise of
+ * the machine (preemption, interrupts), a max of the tables close to it says nothing about them.
+ *
+ * Build: g++ -std=c++17 -O2 ResizeLatency.cpp -o ResizeLatency
+ */
+
+using t_table = HashTable::LinearProbing<long long, long long, HashTable::policy::CapacityPowerOfTwo<long long>>;
+
+const unsigned int SIZE = 1 << 22;
+
+enum Phase
+{
+    OTHER,
+    START,
+    END,
+    MOVING,
+    PHASES
+};
+
+double percentile(const std::vector<double> &sorted, double fraction)
+{
+    return sorted.empty() ? 0 : sorted[static_cast<size_t>(fraction * (sorted.size() - 1))];
+}
+
+void print(const char *name, std::vector<double> &latencies, bool valid)
+{
+    double total = 0;
+
+    for (double latency : latencies)
+        total += latency;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("%-22s %10zu %10.0f %10.0f %10.0f %12.1f %12.1f %10s\n", name, latencies.size(), percentile(latencies, 0.5), percentile(latencies, 0.99),
+                percentile(latencies, 0.999), latencies.empty() ? 0 : latencies.back() / 1e3, total / 1e6, valid ? "" : "error");
+    std::fflush(stdout);
+}
+
+void measure(const char *name, const std::vector<long long> &keys, bool incremental)
+{
+    t_table table;
+    std::vector<double> latencies(keys.size());
+    std::vector<double> phases[PHASES];
+
+    table.setIncrementalRehash(incremental);
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        bool before = table.rehashing();
+        auto start = std::chrono::steady_clock::now();
+
+        table.add(keys[i], i);
+
+        latencies[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        bool after = table.rehashing();
+        phases[before ? (after ? MOVING : END) : (after ? START : OTHER)].push_back(latencies[i]);
+    }
+
+    bool valid = table.size() == keys.size();
+
+    print(name, latencies, valid);
+
+    if (!incremental)
+        return;
+
+    print("  while moving", phases[MOVING], valid);
+    print("  starting a move", phases[START], valid);
+    print("  ending a move", phases[END], valid);
+    print("  other", phases[OTHER], valid);
+}
+
+void measureTimer()
+{
+    std::vector<double> latencies(SIZE);
+    volatile unsigned int counter = 0;
+
+    for (double &latency : latencies)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        counter = counter + 1;
+
+        latency = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    print("timer", latencies, true);
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    std::vector<long long> keys(SIZE);
+
+    for (long long &key : keys)
+        key = static_cast<long long>(random());
+
+    std::printf("%u adds of random keys from the default capacity\n\n", SIZE);
+    std::printf("%-22s %10s %10s %10s %10s %12s %12s\n", "rehash", "adds", "p50, ns", "p99, ns", "p999, ns", "max, us", "total, ms");
+
+    measureTimer();
+    measure("stop-the-world", keys, false);
+    measure("incremental", keys, true);
+}
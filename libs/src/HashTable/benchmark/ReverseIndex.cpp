@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../Bidirectional.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * contains(data) of LinearProbing and LinearProbingChainMethod, which walks the whole table, against
+ * the same tables wrapped in Bidirectional, which looks the value up in its reverse index. Every
+ * table holds SIZE keys with unique values; half of the looked up values are in it. Also prints the
+ * time to add the keys and the memory of the reverse index per element.
+ *
+ * Build: g++ -std=c++17 -O2 ReverseIndex.cpp -o ReverseIndex
+ */
+
+using t_key = long long;
+using t_linear = HashTable::LinearProbing<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>;
+using t_chain = HashTable::LinearProbingChainMethod<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>;
+
+const unsigned int SIZE = 1 << 20;
+// The walks take milliseconds each, they get fewer lookups than the index.
+const unsigned int SCAN_LOOKUPS = 200;
+const unsigned int INDEX_LOOKUPS = 1 << 20;
+
+template <class Ttable>
+double fill(Ttable &table, const std::vector<t_key> &keys)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (t_key key : keys)
+        table.add(key, ~key);
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Ttable>
+void lookup(const char *name, const Ttable &table, const std::vector<t_key> &keys, unsigned int lookups, double addTime, std::size_t indexBytes)
+{
+    std::mt19937_64 random(2);
+    unsigned int found = 0;
+    unsigned int expected = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < lookups; ++i)
+    {
+        // Even rounds: the value of a key of the table, odd rounds: a value no key has.
+        bool present = !(i & 1);
+        t_key key = keys[random() % keys.size()];
+
+        expected += present;
+        found += table.contains(present ? ~key : key);
+    }
+
+    double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / lookups;
+
+    std::printf("%-36s %10u %10.1f %14.1f %12.1f %8s\n", name, table.size(), addTime, time, static_cast<double>(indexBytes) / table.size(), found == expected ? "" : "error");
+    std::fflush(stdout);
+}
+
+template <class Ttable>
+void measure(const char *name, const char *bidirectionalName, const std::vector<t_key> &keys)
+{
+    {
+        Ttable table;
+        double addTime = fill(table, keys);
+
+        lookup(name, table, keys, SCAN_LOOKUPS, addTime, 0);
+    }
+    {
+        HashTable::Bidirectional<Ttable> table;
+        double addTime = fill(table, keys);
+
+        lookup(bidirectionalName, table, keys, INDEX_LOOKUPS, addTime, table.indexBytes());
+    }
+}
+
+int main()
+{
+    std::mt19937_64 random(1);
+    std::vector<t_key> keys(SIZE);
+
+    // Positive keys, the values ~key are negative: the absent values are the keys themselves.
+    for (t_key &key : keys)
+        key = static_cast<t_key>(random() >> 1);
+
+    std::printf("%u keys with unique values, add time in ms\n\n", SIZE);
+    std::printf("%-36s %10s %10s %14s %12s\n", "table", "size", "add", "contains, ns", "index B/item");
+
+    measure<t_linear>("LinearProbing", "Bidirectional<LinearProbing>", keys);
+    measure<t_chain>("LinearProbingChainMethod", "Bidirectional<ChainMethod>", keys);
+}
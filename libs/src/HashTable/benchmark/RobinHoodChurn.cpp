@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../RobinHoodProbing.cc"
+
+/**
+ * Insert/erase churn at a fixed load factor: LinearProbing accumulates tombstones until they
+ * take it over loadFactorMax and it rebuilds at the same capacity, RobinHoodProbing shifts elements back. After every round prints the probe length statistics
+ * of RobinHoodProbing and the miss latency of both tables. A round replaces a quarter of the keys.
+ *
+ * Build: g++ -std=c++17 -O2 RobinHoodChurn.cpp -o RobinHoodChurn
+ */
+
+const unsigned int CAPACITY = 65537;
+const unsigned int SIZE = CAPACITY * 7 / 10;
+const unsigned int ROUNDS = 10;
+const unsigned int CHURN = SIZE / 4;
+const unsigned int MISSES = 10000;
+
+// Present keys are even, missing keys are odd.
+int presentKey(std::mt19937 &random)
+{
+    return static_cast<int>(random() >> 2) * 2;
+}
+
+int missingKey(std::mt19937 &random)
+{
+    return static_cast<int>(random() >> 2) * 2 + 1;
+}
+
+template <class Ttable>
+double missLatency(Ttable &table)
+{
+    std::mt19937 random(7);
+    unsigned int found = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < MISSES; ++i)
+        found += table.containsKey(missingKey(random));
+
+    auto time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    return found ? -1 : time / MISSES;
+}
+
+int main()
+{
+    HashTable::LinearProbing<int, int> linear(CAPACITY, 0.25, 0.99);
+    HashTable::RobinHoodProbing<int, int> robinHood(CAPACITY, 0.25, 0.99);
+
+    std::mt19937 random(1);
+    std::vector<int> keys;
+
+    while (keys.size() < SIZE)
+    {
+        int key = presentKey(random);
+
+        if (robinHood.containsKey(key))
+            continue;
+
+        linear.insert(key, key);
+        robinHood.insert(key, key);
+        keys.push_back(key);
+    }
+
+    std::printf("capacity %u, size %u, load factor %.2f\n\n", CAPACITY, SIZE, robinHood.loadFactor());
+    std::printf("%6s %12s %12s %8s %18s %18s\n", "round", "psl mean", "psl var", "psl max", "linear miss, ns", "robin miss, ns");
+
+    for (unsigned int round = 0; round <= ROUNDS; ++round)
+    {
+        if (round)
+        {
+            for (unsigned int i = 0; i < CHURN; ++i)
+            {
+                unsigned int index = random() % keys.size();
+                linear.erase(keys[index]);
+                robinHood.erase(keys[index]);
+
+                int key = presentKey(random);
+
+                while (robinHood.containsKey(key))
+                    key = presentKey(random);
+
+                linear.insert(key, key);
+                robinHood.insert(key, key);
+                keys[index] = key;
+            }
+        }
+
+        HashTable::RobinHoodProbeStatistics statistics = robinHood.probeStatistics();
+
+        std::printf("%6u %12.3f %12.3f %8u %18.1f %18.1f\n", round, statistics.mean, statistics.variance, statistics.max, missLatency(linear), missLatency(robinHood));
+        std::fflush(stdout);
+    }
+}
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * save and load of a table of SIZE elements through a std::stringstream and through a buffer, for
+ * LinearProbing and LinearProbingChainMethod with 64-bit and std::string keys. Also prints the size
+ * of the output per element and the capacity changes during load (none: it reserves the count first).
+ *
+ * Build: g++ -std=c++17 -O2 Serialization.cpp -o Serialization
+ */
+
+const unsigned int SIZE = 1 << 21;
+
+double since(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Ttable>
+bool same(const Ttable &table, Ttable &loaded)
+{
+    if (loaded.size() != table.size())
+        return false;
+
+    for (const auto &item : table)
+    {
+        if (!loaded.containsKey(item.key))
+            return false;
+    }
+
+    return true;
+}
+
+template <class Ttable>
+void measure(const char *name, const Ttable &table)
+{
+    std::stringstream stream;
+    std::string buffer;
+
+    auto start = std::chrono::steady_clock::now();
+    table.save(stream);
+    double saveStream = since(start);
+
+    start = std::chrono::steady_clock::now();
+    table.save(buffer);
+    double saveBuffer = since(start);
+
+    Ttable fromStream;
+    Ttable fromBuffer;
+
+    start = std::chrono::steady_clock::now();
+    fromStream.load(stream);
+    double loadStream = since(start);
+
+    start = std::chrono::steady_clock::now();
+    fromBuffer.load(buffer.data(), buffer.size());
+    double loadBuffer = since(start);
+
+    bool valid = same(table, fromStream) && same(table, fromBuffer);
+
+    std::printf("%-36s %10.1f %10.1f %10.1f %10.1f %10.1f %8s\n", name, saveStream, loadStream, saveBuffer, loadBuffer, static_cast<double>(buffer.size()) / table.size(), valid ? "" : "error");
+    std::fflush(stdout);
+}
+
+template <class Tkey, class Tmake>
+void measure(const char *linearName, const char *chainName, Tmake make)
+{
+    HashTable::LinearProbing<Tkey, Tkey, HashTable::policy::CapacityPowerOfTwo<Tkey>> linear;
+    HashTable::LinearProbingChainMethod<Tkey, Tkey, HashTable::policy::CapacityPowerOfTwo<Tkey>> chain;
+    std::mt19937_64 random(1);
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+    {
+        Tkey key = make(random());
+
+        linear.add(key, key);
+        chain.add(key, key);
+    }
+
+    measure(linearName, linear);
+    measure(chainName, chain);
+}
+
+int main()
+{
+    std::printf("%u elements, times in ms\n\n", SIZE);
+    std::printf("%-36s %10s %10s %10s %10s %10s\n", "table", "save", "load", "save buf", "load buf", "B/item");
+
+    measure<long long>("LinearProbing<long long>", "ChainMethod<long long>", [](unsigned long long value) { return static_cast<long long>(value); });
+    measure<std::string>("LinearProbing<std::string>", "ChainMethod<std::string>", [](unsigned long long value) { return "key:" + std::to_string(value); });
+}
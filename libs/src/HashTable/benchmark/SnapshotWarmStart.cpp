@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../LinearProbing.cc"
+#include "../Snapshot.cc"
+
+/**
+ * Warm start of a table of SIZE elements: rebuilt by add row by row, against a Snapshot written
+ * once and mapped again. The mapped table is timed up to its first lookup and up to LOOKUPS random
+ * lookups; the file is dropped from the page cache before mapping (posix_fadvise), so the lookups
+ * pay the page faults of a cold start as far as the kernel honours it. Keys are 64-bit integers,
+ * then std::string with string data in the arena.
+ *
+ * Build: g++ -std=c++17 -O2 SnapshotWarmStart.cpp -o SnapshotWarmStart
+ */
+
+const unsigned int SIZE = 1 << 22;
+const unsigned int LOOKUPS = 1 << 20;
+const char *const PATH = "SnapshotWarmStart.snap";
+
+double since(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void dropCache(const char *path)
+{
+    int descriptor = open(path, O_RDONLY);
+
+    if (descriptor < 0)
+        return;
+
+    posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+    close(descriptor);
+}
+
+template <class Tkey, class Tdata, class Tmake>
+void measure(const char *name, Tmake make)
+{
+    using t_table = HashTable::LinearProbing<Tkey, Tdata, HashTable::policy::CapacityPowerOfTwo<Tkey>>;
+    using t_snapshot = HashTable::Snapshot<Tkey, Tdata>;
+
+    std::vector<Tkey> keys;
+    std::vector<Tdata> data;
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+    {
+        keys.push_back(make(i));
+        data.push_back(make(~i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    t_table table;
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        table.add(keys[i], data[i]);
+
+    double addTime = since(start);
+
+    start = std::chrono::steady_clock::now();
+    t_snapshot::write(table, PATH);
+
+    double writeTime = since(start);
+
+    dropCache(PATH);
+
+    std::mt19937_64 random(1);
+    unsigned int found = 0;
+
+    start = std::chrono::steady_clock::now();
+
+    t_snapshot snapshot(PATH);
+
+    found += snapshot.containsKey(keys[0]);
+
+    double openTime = since(start);
+
+    for (unsigned int i = 1; i < LOOKUPS; ++i)
+        found += snapshot.containsKey(keys[random() % SIZE]);
+
+    double lookupTime = since(start);
+
+    std::printf("%-12s %10u %12.1f %12.1f %12.3f %14.1f %12.1f %8s\n", name, snapshot.size(), addTime, writeTime, openTime, lookupTime, static_cast<double>(snapshot.bytes()) / snapshot.size(), found == LOOKUPS ? "" : "error");
+    std::fflush(stdout);
+
+    std::remove(PATH);
+}
+
+int main()
+{
+    std::printf("%u elements, %u lookups after mapping, times in ms\n\n", SIZE, LOOKUPS);
+    std::printf("%-12s %10s %12s %12s %12s %14s %12s\n", "keys", "size", "add all", "write", "map + 1", "map + lookups", "file B/item");
+
+    measure<long long, long long>("long long", [](unsigned int i) { return static_cast<long long>(i) * 0x9E3779B97F4A7C15ll; });
+    measure<std::string, std::string>("std::string", [](unsigned int i) { return "row:" + std::to_string(i); });
+}
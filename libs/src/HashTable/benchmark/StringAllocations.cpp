@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+#include "CountingAllocator.cc"
+
+/**
+ * Heap allocations per element while SIZE pairs of long strings are added to a table growing
+ * from the default capacity, with the pairs copied in, moved in and with the data constructed
+ * in place (the data string is built from its characters). The strings are longer than the
+ * small string buffer, so a copied pair costs 2 allocations; the slot arrays, buckets and
+ * chain nodes come on top of that.
+ *
+ * Build: g++ -std=c++17 -O2 StringAllocations.cpp -o StringAllocations
+ */
+
+const unsigned int SIZE = 1 << 18;
+const unsigned int STRING_LENGTH = 64;
+
+std::string makeString(char tag, unsigned int number)
+{
+    std::string result(STRING_LENGTH, tag);
+    std::string digits = std::to_string(number);
+
+    return result.replace(0, digits.size(), digits);
+}
+
+template <class Ttable, class Tadd>
+void measure(const char *name, Tadd add)
+{
+    std::vector<std::string> keys, values;
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+    {
+        keys.push_back(makeString('k', i));
+        values.push_back(makeString('v', i));
+    }
+
+    Ttable table;
+
+    unsigned long long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < SIZE; ++i)
+        add(table, keys[i], values[i]);
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-28s %18.2f %12.1f %8s\n", name, static_cast<double>(allocations - before) / SIZE, milliseconds,
+                table.size() == SIZE ? "" : "error");
+    std::fflush(stdout);
+}
+
+template <class Ttable>
+void measureAll(const char *name)
+{
+    std::printf("%s\n", name);
+
+    measure<Ttable>("  copy", [](Ttable &table, std::string &key, std::string &value) { table.add(key, value); });
+    measure<Ttable>("  move", [](Ttable &table, std::string &key, std::string &value) { table.add(std::move(key), std::move(value)); });
+    measure<Ttable>("  emplace", [](Ttable &table, std::string &key, std::string &value) { table.emplace(std::move(key), value.data(), value.size()); });
+}
+
+int main()
+{
+    std::printf("%u pairs of %u-byte strings\n\n", SIZE, STRING_LENGTH);
+    std::printf("%-28s %18s %12s\n", "table", "allocations/pair", "time, ms");
+
+    measureAll<HashTable::LinearProbing<std::string, std::string, HashTable::policy::CapacityPowerOfTwo<std::string>>>("LinearProbing");
+    measureAll<HashTable::LinearProbingChainMethod<std::string, std::string, HashTable::policy::CapacityPowerOfTwo<std::string>>>("LinearProbingChainMethod");
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../HashFunctions/FunctionModulus.cc"
+#include "../HashFunctions/FunctionFibonacci.cc"
+#include "../HashFunctions/FunctionWyhash.cc"
+
+/**
+ * Quality and speed of the string hashes on locally generated key corpora.
+ *
+ * For every corpus and hash prints: full-width collisions, the fullest of BUCKETS buckets
+ * against the expected mean, and hashing throughput in GB/s.
+ *
+ * Build: g++ -std=c++17 -O2 StringHash.cpp -o StringHash
+ */
+
+const unsigned int BUCKETS = 1 << 16;
+const unsigned int REPEATS = 20;
+
+// Keeps the hashing loops from being optimized away.
+volatile unsigned long long sink;
+
+std::vector<std::string> identifiers(std::mt19937 &random)
+{
+    std::vector<std::string> result;
+
+    for (unsigned int i = 0; i < 200000; ++i)
+        result.push_back("user_" + std::to_string(random() % 100000000));
+
+    return result;
+}
+
+std::vector<std::string> urls(std::mt19937 &random)
+{
+    const char *hosts[] = {"example.com", "cdn.example.net", "api.service.io", "static.files.org"};
+    std::vector<std::string> result;
+
+    for (unsigned int i = 0; i < 200000; ++i)
+    {
+        std::string url = std::string("https://") + hosts[random() % 4];
+
+        for (unsigned int segments = 2 + random() % 5; segments; --segments)
+            url += "/segment" + std::to_string(random() % 1000);
+
+        result.push_back(url + "?id=" + std::to_string(i));
+    }
+
+    return result;
+}
+
+// Permutations of the same characters: every positional-sum collision shows up here.
+std::vector<std::string> anagrams(std::mt19937 &random)
+{
+    std::vector<std::string> result;
+    std::string base = "abcdefghijklmnop";
+
+    for (unsigned int i = 0; i < 200000; ++i)
+    {
+        std::shuffle(base.begin(), base.end(), random);
+        result.push_back(base);
+    }
+
+    return result;
+}
+
+std::vector<std::string> blobs(std::mt19937 &random)
+{
+    std::vector<std::string> result;
+
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        std::string blob(1024 + random() % 3072, ' ');
+
+        for (char &c : blob)
+            c = static_cast<char>(random());
+
+        result.push_back(blob);
+    }
+
+    return result;
+}
+
+// highBits: buckets are taken from the high bits of the hash, as policy::CapacityPowerOfTwo does,
+// otherwise the hash is reduced by the division, as policy::CapacityModulus does.
+template <class Tfunction>
+void measure(const char *corpus, const char *name, const std::vector<std::string> &keys, const Tfunction &function, bool highBits)
+{
+    std::unordered_set<std::string> distinctKeys(keys.begin(), keys.end());
+    std::unordered_set<unsigned long long> distinctHashes;
+    std::vector<unsigned int> buckets(BUCKETS, 0);
+
+    for (const std::string &key : distinctKeys)
+    {
+        unsigned long long hash = function(key);
+
+        distinctHashes.insert(hash);
+        ++buckets[highBits ? hash >> 48 : hash % BUCKETS];
+    }
+
+    unsigned int fullest = 0;
+
+    for (unsigned int bucket : buckets)
+        fullest = bucket > fullest ? bucket : fullest;
+
+    unsigned long long bytes = 0, checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int repeat = 0; repeat < REPEATS; ++repeat)
+    {
+        for (const std::string &key : keys)
+        {
+            checksum += function(key);
+            bytes += key.size();
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    sink = checksum;
+
+    std::printf("%-12s %-10s %10zu %12zu %10u %10.1f %10.2f\n", corpus, name, distinctKeys.size(), distinctKeys.size() - distinctHashes.size(),
+                fullest, static_cast<double>(distinctKeys.size()) / BUCKETS, bytes / seconds / 1e9);
+}
+
+void measureAll(const char *corpus, const std::vector<std::string> &keys)
+{
+    // Modulus of 2^32 - 1 keeps the whole positional sum.
+    HashFunctions::FunctionModulus<std::string> modulus(0xFFFFFFFFu);
+    HashFunctions::FunctionFibonacci<std::string> fibonacci;
+    HashFunctions::FunctionWyhash wyhash;
+
+    measure(corpus, "modulus", keys, [&](const std::string &key) { return static_cast<unsigned long long>(modulus.hash(key)); }, false);
+    measure(corpus, "fibonacci", keys, [&](const std::string &key) { return fibonacci.hash(key); }, true);
+    measure(corpus, "wyhash", keys, [&](const std::string &key) { return wyhash.hash(key); }, true);
+}
+
+int main()
+{
+    std::mt19937 random(1);
+
+    std::printf("%-12s %-10s %10s %12s %10s %10s %10s\n", "corpus", "hash", "keys", "collisions", "fullest", "mean", "GB/s");
+
+    measureAll("identifiers", identifiers(random));
+    measureAll("urls", urls(random));
+    measureAll("anagrams", anagrams(random));
+    measureAll("blobs", blobs(random));
+}
@@ -0,0 +1,363 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * LinearProbing, LinearProbingChainMethod and std::unordered_map side by side, for 32-bit, 64-bit
+ * and std::string keys, sizes from --min to --max by powers of ten (1K..100M by default) and the
+ * maximum load factors 0.5, 0.75 and 0.9 (max_load_factor for std::unordered_map). Every case:
+ *
+ *     insert  - add of every key after reserve(size);
+ *     grow    - add of every key from the default capacity, the resize-heavy path;
+ *     hit     - lookup of every key, in the order of insertion;
+ *     miss    - lookup of as many absent keys;
+ *     churn   - remove of a key and add of a new one, "size" times;
+ *     iterate - a walk over all the elements;
+ *
+ * in ns per element, and the growth of the resident set (RSS, /proc/self/statm) of the table built
+ * by "grow", in bytes per element. Each case runs in a child process of its own, so the memory
+ * freed by one case does not hide the memory of the next. A case that dies (e.g. out of memory)
+ * is reported on stderr and skipped.
+ *
+ * Output: CSV with a header line (--format=csv, the default), or one JSON object per line (--format=json).
+ * Linux only (fork, /proc).
+ *
+ * Build: g++ -std=c++17 -O2 Suite.cpp -o Suite
+ * Run:   ./Suite --max=1000000 --format=json > results.json
+ */
+
+using t_data = std::uint64_t;
+
+const HashTable::consts::t_stat LOAD_FACTORS[] = {0.5f, 0.75f, 0.9f};
+
+enum Format
+{
+    CSV,
+    JSON
+};
+
+struct Result
+{
+    double insert;
+    double grow;
+    double hit;
+    double miss;
+    double churn;
+    double iterate;
+    double rssPerElement;
+    bool valid;
+};
+
+// Murmur finalizer: a bijection, distinct numbers give distinct keys.
+std::uint64_t mix(std::uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+
+    return value;
+}
+
+struct IntKeys
+{
+    using t_key = std::uint32_t;
+    static constexpr const char *name = "int32";
+
+    static t_key make(std::uint64_t i)
+    {
+        // Odd multiplier: a bijection of the 32-bit numbers.
+        return static_cast<t_key>(i) * 0x9E3779B1u;
+    }
+};
+
+struct LongKeys
+{
+    using t_key = std::uint64_t;
+    static constexpr const char *name = "int64";
+
+    static t_key make(std::uint64_t i)
+    {
+        return mix(i);
+    }
+};
+
+struct StringKeys
+{
+    using t_key = std::string;
+    static constexpr const char *name = "string";
+
+    static t_key make(std::uint64_t i)
+    {
+        return "key:" + std::to_string(mix(i));
+    }
+};
+
+long residentBytes()
+{
+    long pages = 0;
+    long resident = 0;
+    FILE *file = std::fopen("/proc/self/statm", "r");
+
+    if (!file)
+        return 0;
+
+    if (std::fscanf(file, "%ld %ld", &pages, &resident) != 2)
+        resident = 0;
+
+    std::fclose(file);
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+double since(const std::chrono::steady_clock::time_point &start, std::uint64_t count)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+// The same few calls on the tables of the library and on std::unordered_map.
+template <class Tkey>
+struct Ours
+{
+    template <class Ttable>
+    static Ttable make(HashTable::consts::t_stat loadFactorMax)
+    {
+        return Ttable(HashTable::consts::DEFAULT_CAPACITY, std::min(HashTable::consts::DEFAULT_LOAD_FACTOR_MIN, loadFactorMax / 2), loadFactorMax);
+    }
+
+    template <class Ttable>
+    static bool add(Ttable &table, const Tkey &key, t_data data)
+    {
+        return table.add(key, data);
+    }
+
+    template <class Ttable>
+    static bool contains(Ttable &table, const Tkey &key)
+    {
+        return table.containsKey(key);
+    }
+
+    template <class Ttable>
+    static bool remove(Ttable &table, const Tkey &key)
+    {
+        return table.remove(key);
+    }
+
+    template <class Titem>
+    static t_data data(const Titem &item)
+    {
+        return item.data;
+    }
+};
+
+template <class Tkey>
+struct Standard
+{
+    template <class Ttable>
+    static Ttable make(HashTable::consts::t_stat loadFactorMax)
+    {
+        Ttable table;
+
+        table.max_load_factor(loadFactorMax);
+        return table;
+    }
+
+    template <class Ttable>
+    static bool add(Ttable &table, const Tkey &key, t_data data)
+    {
+        return table.emplace(key, data).second;
+    }
+
+    template <class Ttable>
+    static bool contains(Ttable &table, const Tkey &key)
+    {
+        return table.find(key) != table.end();
+    }
+
+    template <class Ttable>
+    static bool remove(Ttable &table, const Tkey &key)
+    {
+        return table.erase(key);
+    }
+
+    template <class Titem>
+    static t_data data(const Titem &item)
+    {
+        return item.second;
+    }
+};
+
+template <class Ttable, class Tcalls, class Tkeys>
+Result run(std::uint64_t size, HashTable::consts::t_stat loadFactorMax)
+{
+    using Tkey = typename Tkeys::t_key;
+
+    std::vector<Tkey> keys(size);
+    std::vector<Tkey> absent(size);
+    Result result{};
+    t_data expected = 0;
+    t_data sum = 0;
+    std::uint64_t count = 0;
+
+    result.valid = true;
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        keys[i] = Tkeys::make(i);
+        absent[i] = Tkeys::make(i + size);
+        expected += i;
+    }
+
+    // The first table is measured on a fresh heap: memory freed by an earlier one would be reused unseen.
+    {
+        long rss = residentBytes();
+        Ttable table = Tcalls::template make<Ttable>(loadFactorMax);
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::uint64_t i = 0; i < size; ++i)
+            count += Tcalls::add(table, keys[i], i);
+
+        result.grow = since(start, size);
+        result.rssPerElement = static_cast<double>(residentBytes() - rss) / size;
+
+        start = std::chrono::steady_clock::now();
+
+        for (std::uint64_t i = 0; i < size; ++i)
+            count += Tcalls::contains(table, keys[i]);
+
+        result.hit = since(start, size);
+        start = std::chrono::steady_clock::now();
+
+        for (std::uint64_t i = 0; i < size; ++i)
+            count += Tcalls::contains(table, absent[i]);
+
+        result.miss = since(start, size);
+        start = std::chrono::steady_clock::now();
+
+        for (const auto &item : table)
+            sum += Tcalls::data(item);
+
+        result.iterate = since(start, size);
+
+        // The churn takes the keys out in the order of insertion and brings the absent ones in.
+        start = std::chrono::steady_clock::now();
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            count += Tcalls::remove(table, keys[i]);
+            count += Tcalls::add(table, absent[i], i);
+        }
+
+        result.churn = since(start, size);
+        result.valid = sum == expected && table.size() == size;
+    }
+
+    Ttable table = Tcalls::template make<Ttable>(loadFactorMax);
+    auto start = std::chrono::steady_clock::now();
+
+    table.reserve(size);
+
+    for (std::uint64_t i = 0; i < size; ++i)
+        count += Tcalls::add(table, keys[i], i);
+
+    result.insert = since(start, size);
+    result.valid = result.valid && count == 5 * size;
+
+    return result;
+}
+
+void print(Format format, const char *table, const char *keys, std::uint64_t size, HashTable::consts::t_stat loadFactorMax, const Result &result)
+{
+    if (format == CSV)
+    {
+        std::printf("%s,%s,%llu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.1f,%s\n", table, keys, static_cast<unsigned long long>(size), loadFactorMax, result.insert, result.grow, result.hit, result.miss, result.churn, result.iterate, result.rssPerElement, result.valid ? "ok" : "error");
+    }
+    else
+    {
+        std::printf("{\"table\":\"%s\",\"keys\":\"%s\",\"size\":%llu,\"loadFactorMax\":%.2f,\"insertNs\":%.2f,\"growNs\":%.2f,\"hitNs\":%.2f,\"missNs\":%.2f,\"churnNs\":%.2f,\"iterateNs\":%.2f,\"rssBytesPerElement\":%.1f,\"valid\":%s}\n",
+                    table, keys, static_cast<unsigned long long>(size), loadFactorMax, result.insert, result.grow, result.hit, result.miss, result.churn, result.iterate, result.rssPerElement, result.valid ? "true" : "false");
+    }
+
+    std::fflush(stdout);
+}
+
+// Runs the case in a child process: its memory is counted from a fresh heap and freed when it exits.
+template <class Ttable, class Tcalls, class Tkeys>
+void measure(Format format, const char *table, std::uint64_t size, HashTable::consts::t_stat loadFactorMax)
+{
+    std::fflush(stdout);
+
+    pid_t child = fork();
+
+    if (child == 0)
+    {
+        print(format, table, Tkeys::name, size, loadFactorMax, run<Ttable, Tcalls, Tkeys>(size, loadFactorMax));
+        std::_Exit(0);
+    }
+
+    int status = 0;
+
+    if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status))
+        std::fprintf(stderr, "%s %s %llu %.2f: the case failed (out of memory?), skipped\n", table, Tkeys::name, static_cast<unsigned long long>(size), loadFactorMax);
+}
+
+template <class Tkeys>
+void measure(Format format, std::uint64_t minSize, std::uint64_t maxSize)
+{
+    using Tkey = typename Tkeys::t_key;
+
+    for (std::uint64_t size = minSize; size <= maxSize; size *= 10)
+    {
+        for (HashTable::consts::t_stat loadFactorMax : LOAD_FACTORS)
+        {
+            measure<HashTable::LinearProbing<Tkey, t_data, HashTable::policy::CapacityPowerOfTwo<Tkey>>, Ours<Tkey>, Tkeys>(format, "LinearProbing", size, loadFactorMax);
+            measure<HashTable::LinearProbingChainMethod<Tkey, t_data, HashTable::policy::CapacityPowerOfTwo<Tkey>>, Ours<Tkey>, Tkeys>(format, "LinearProbingChainMethod", size, loadFactorMax);
+            measure<std::unordered_map<Tkey, t_data>, Standard<Tkey>, Tkeys>(format, "std::unordered_map", size, loadFactorMax);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Format format = CSV;
+    std::uint64_t minSize = 1000;
+    std::uint64_t maxSize = 100000000;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--format=json"))
+            format = JSON;
+        else if (!std::strcmp(argv[i], "--format=csv"))
+            format = CSV;
+        else if (!std::strncmp(argv[i], "--min=", 6))
+            minSize = std::strtoull(argv[i] + 6, nullptr, 10);
+        else if (!std::strncmp(argv[i], "--max=", 6))
+            maxSize = std::strtoull(argv[i] + 6, nullptr, 10);
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--format=csv|json] [--min=1000] [--max=100000000]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!minSize)
+        minSize = 1;
+
+    if (format == CSV)
+        std::printf("table,keys,size,loadFactorMax,insertNs,growNs,hitNs,missNs,churnNs,iterateNs,rssBytesPerElement,valid\n");
+
+    measure<IntKeys>(format, minSize, maxSize);
+    measure<LongKeys>(format, minSize, maxSize);
+    measure<StringKeys>(format, minSize, maxSize);
+}
@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "../LinearProbing.cc"
+#include "../LinearProbingChainMethod.cc"
+
+/**
+ * Time to walk every element of a table of CAPACITY slots at several load factors: LinearProbing by
+ * its iterator (free slots skipped 64 at a time through an occupancy bitmap of the control bytes) and
+ * by a check of every slot, LinearProbingChainMethod by its iterator. The time per element shows
+ * how much of the walk goes to the free slots of a sparse table.
+ *
+ * Build: g++ -std=c++17 -O2 Traversal.cpp -o Traversal
+ */
+
+using t_key = long long;
+using t_linear = HashTable::LinearProbing<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>;
+using t_chain = HashTable::LinearProbingChainMethod<t_key, t_key, HashTable::policy::CapacityPowerOfTwo<t_key>>;
+
+const unsigned int CAPACITY = 1 << 22;
+const unsigned int ROUNDS = 10;
+
+// The walk by checking the control byte of every slot, as without the iterator.
+struct SlotBySlot : t_linear
+{
+    t_key sum() const
+    {
+        t_key result = 0;
+
+        for (HashTable::consts::t_uIndex i = 0; i < this->capacity(); ++i)
+        {
+            if (this->table.isOccupied(i))
+                result += this->table.getData(i);
+        }
+
+        return result;
+    }
+};
+
+template <class Ttable>
+t_key iterate(const Ttable &table)
+{
+    t_key result = 0;
+
+    for (const auto &item : table)
+        result += item.data;
+
+    return result;
+}
+
+template <class Ttable, class Tfunction>
+void measure(const char *name, const Ttable &table, t_key expected, Tfunction walk)
+{
+    t_key sum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int round = 0; round < ROUNDS; ++round)
+    {
+        sum += walk(table);
+
+        // Every round walks the table again instead of reusing the sum of the first one.
+        asm volatile("" ::: "memory");
+    }
+
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+
+    std::printf("%-26s %10u %10u %10.2f %12.2f %8s\n", name, table.capacity(), table.size(), time, time * 1e6 / table.size(), sum == expected * ROUNDS ? "" : "error");
+    std::fflush(stdout);
+}
+
+int main()
+{
+    std::printf("%u slots, mean of %u walks\n\n", CAPACITY, ROUNDS);
+    std::printf("%-26s %10s %10s %10s %12s\n", "walk", "capacity", "size", "time, ms", "per item, ns");
+
+    for (double load : {0.005, 0.05, 0.25, 0.7})
+    {
+        std::mt19937_64 random(1);
+        unsigned int size = static_cast<unsigned int>(CAPACITY * load);
+        SlotBySlot linear;
+        t_chain chain;
+        t_key expected = 0;
+
+        // rehash keeps the capacity for any number of elements.
+        linear.rehash(CAPACITY);
+        chain.rehash(CAPACITY);
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            t_key key = static_cast<t_key>(random() >> 1);
+
+            if (linear.add(key, key))
+                expected += key;
+            chain.add(key, key);
+        }
+
+        measure("LinearProbing, iterator", linear, expected, iterate<t_linear>);
+        measure("LinearProbing, every slot", linear, expected, [](const SlotBySlot &table) { return table.sum(); });
+        measure("ChainMethod, iterator", chain, expected, iterate<t_chain>);
+    }
+}